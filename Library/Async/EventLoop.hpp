@@ -1,36 +1,283 @@
 #pragma once
 
 #include <string>
-#include <list>
 #include <thread>
-#include <mutex>
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <optional>
+#include <variant>
+#include <exception>
+#include <coroutine>
 #include <functional>
+#include <pthread.h>
 
 #include <Event.hpp>
 #include <Timer.hpp>
 #include <Duration.hpp>
 #include <Function.hpp>
 #include <TimeWheel.hpp>
+#include <Async/Metrics.hpp>
 #include <ePoll.hpp>
+#include <uRing.hpp>
 #include <Iterable/Queue.hpp>
+#include <Iterable/Slab.hpp>
 #include <Network/Socket.hpp>
 #include <Network/HTTP/Response.hpp>
 #include <Network/HTTP/Request.hpp>
 #include <Network/HTTP/Parser.hpp>
 
+#ifndef SO_PREFER_BUSY_POLL
+#define SO_PREFER_BUSY_POLL 69
+#endif
+
 // @todo Safety of assign caller thread
 
 namespace Core::Async
 {
+    /**
+     * @brief Lock-free multi-producer single-consumer intrusive queue
+     * Producers push nodes onto an atomic stack and the consumer swaps
+     * the whole stack out at once, so running a batch never holds a lock.
+     */
+    class ActionQueue
+    {
+    public:
+        struct Node
+        {
+            Node *Next = nullptr;
+
+            // Runs the node if Execute is set and releases it either way
+            void (*Invoke)(Node *, bool Execute) = nullptr;
+        };
+
+        template <typename TCallback>
+        struct Action : public Node
+        {
+            TCallback Callback;
+
+            template <typename T>
+            Action(T &&callback) : Node{nullptr, &Action::Run}, Callback(std::forward<T>(callback)) {}
+
+            static void Run(Node *Self, bool Execute)
+            {
+                std::unique_ptr<Action> Item(static_cast<Action *>(Self));
+
+                if (Execute)
+                    Item->Callback();
+            }
+        };
+
+        ActionQueue() = default;
+        ActionQueue(ActionQueue const &Other) = delete;
+        ActionQueue(ActionQueue &&Other) noexcept : Head(Other.Head.exchange(nullptr, std::memory_order_acq_rel)) {}
+
+        ~ActionQueue()
+        {
+            Free();
+        }
+
+        ActionQueue &operator=(ActionQueue const &Other) = delete;
+        ActionQueue &operator=(ActionQueue &&Other) noexcept
+        {
+            if (this != &Other)
+            {
+                Free();
+                Head.store(Other.Head.exchange(nullptr, std::memory_order_acq_rel), std::memory_order_release);
+            }
+
+            return *this;
+        }
+
+        /**
+         * @brief Pushes a node, safe to call from any thread
+         * @return true if the queue was empty before this push
+         */
+        bool Push(Node *Item)
+        {
+            Item->Next = Head.load(std::memory_order_relaxed);
+
+            // Sequentially consistent so a push can't be missed by a consumer
+            // that clears its wake flag right before taking the batch
+
+            while (!Head.compare_exchange_weak(Item->Next, Item, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+            }
+
+            return Item->Next == nullptr;
+        }
+
+        template <typename TCallback>
+        bool Add(TCallback &&Callback)
+        {
+            return Push(new Action<std::decay_t<TCallback>>(std::forward<TCallback>(Callback)));
+        }
+
+        /**
+         * @brief Detaches every pushed node in one exchange
+         * @return First node of the batch in insertion order
+         */
+        Node *Take()
+        {
+            Node *Item = Head.exchange(nullptr, std::memory_order_seq_cst);
+            Node *Result = nullptr;
+
+            while (Item)
+            {
+                Node *Next = Item->Next;
+                Item->Next = Result;
+                Result = Item;
+                Item = Next;
+            }
+
+            return Result;
+        }
+
+        /**
+         * @brief Runs the current batch, only the consumer thread may call this
+         * A throwing node doesn't stop the batch, the first exception is
+         * rethrown once every node of it ran
+         * @return Number of nodes that were run
+         */
+        size_t Run()
+        {
+            size_t Count = 0;
+            Node *Item = Take();
+            std::exception_ptr Error;
+
+            while (Item)
+            {
+                Node *Next = Item->Next;
+
+                try
+                {
+                    Item->Invoke(Item, true);
+                }
+                catch (...)
+                {
+                    if (!Error)
+                        Error = std::current_exception();
+                }
+
+                Item = Next;
+                ++Count;
+            }
+
+            if (Error)
+                std::rethrow_exception(Error);
+
+            return Count;
+        }
+
+        inline bool IsEmpty() const
+        {
+            return Head.load(std::memory_order_relaxed) == nullptr;
+        }
+
+        void Free()
+        {
+            Release(Take());
+        }
+
+    private:
+        std::atomic<Node *> Head{nullptr};
+
+        static void Release(Node *Item)
+        {
+            while (Item)
+            {
+                Node *Next = Item->Next;
+                Item->Invoke(Item, false);
+                Item = Next;
+            }
+        }
+    };
+
+    class Executor;
+
+    template <typename TCallback>
+    class Offloaded;
+
     class EventLoop
     {
     public:
         struct Entry;
         struct Context;
 
+        /**
+         * @brief Readiness backends a loop can poll with
+         * ePoll : epoll_ctl for every interest change and epoll_wait
+         * uRing : Interest changes batched into the io_uring_enter that waits,
+         * and ring timeouts in place of the expire timer
+         */
+        enum class Backends
+        {
+            ePoll,
+            uRing,
+        };
+
+#ifdef COREKIT_IO_URING
+        static constexpr Backends DefaultBackend = Backends::uRing;
+#else
+        static constexpr Backends DefaultBackend = Backends::ePoll;
+#endif
+
+        /**
+         * @brief The backend picked when the loop is constructed
+         */
+        class Poller
+        {
+        public:
+            Poller() = default;
+
+            Poller(Backends Kind)
+            {
+                // Deep enough for a full default batch to complete in one wait
+
+                if (Kind == Backends::uRing)
+                    Backend.emplace<uRing>(0, 512);
+                else
+                    Backend.emplace<ePoll>(0);
+            }
+
+            inline void Add(Descriptor const &File, uint32_t Events, uint64_t Data)
+            {
+                std::visit([&](auto &Poll) { Poll.Add(File, Events, Data); }, Backend);
+            }
+
+            inline void Modify(Descriptor const &File, uint32_t Events, uint64_t Data)
+            {
+                std::visit([&](auto &Poll) { Poll.Modify(File, Events, Data); }, Backend);
+            }
+
+            inline void Delete(Descriptor const &File)
+            {
+                std::visit([&](auto &Poll) { Poll.Delete(File); }, Backend);
+            }
+
+            inline void operator()(ePoll::List &Items, int Timeout = -1)
+            {
+                std::visit([&](auto &Poll) { Poll(Items, Timeout); }, Backend);
+            }
+
+            inline size_t Syscalls() const
+            {
+                return std::visit([](auto const &Poll) { return Poll.Syscalls(); }, Backend);
+            }
+
+            inline Backends Kind() const
+            {
+                return Backend.index() ? Backends::uRing : Backends::ePoll;
+            }
+
+        private:
+            std::variant<ePoll, uRing> Backend;
+        };
+
+        using PollType = Poller;
         using TimeWheelType = TimeWheel<32, 5>;
-        using Container = std::list<Entry>;
+        using Handle = Iterable::SlabHandle;
+        using Container = Iterable::Slab<Entry>;
         using CallbackType = Core::Function<void(EventLoop::Context &, ePoll::Entry &)>;
         using EndCallbackType = Core::Function<void()>;
 
@@ -39,9 +286,23 @@ namespace Core::Async
             Descriptor File;
             CallbackType Callback;
             EndCallbackType End;
-            Container::iterator Iterator;
+            Handle Id;
             TimeWheelType::Bucket::Iterator Timer;
 
+            // Idle timeout bookkeeping in loop milliseconds, Deadline is where
+            // activity pushed the timeout and Expiry is where the wheel fires
+
+            size_t Deadline = 0;
+            size_t Expiry = 0;
+
+            // Interest currently registered with the poller
+
+            ePoll::Event Events = 0;
+
+            // Whether the entry counts towards Connections, listeners don't
+
+            bool Counted = true;
+
             template <typename T>
             inline T *CallbackAs()
             {
@@ -49,6 +310,13 @@ namespace Core::Async
             }
         };
 
+        struct Assignment
+        {
+            Descriptor File;
+            CallbackType Callback;
+            EndCallbackType End;
+        };
+
         struct Context
         {
             EventLoop &Loop;
@@ -85,7 +353,7 @@ namespace Core::Async
             {
                 // Loop.AssertPermission();
 
-                Loop.Remove(Self.Iterator);
+                Loop.Remove(Self.Id);
             }
 
             template <typename TCallback>
@@ -114,15 +382,147 @@ namespace Core::Async
             {
                 Loop.Upgrade(Self, std::forward<TCallback>(Callback), Timeout, Events);
             }
+
+            template <typename TCallback>
+            inline auto Offload(TCallback &&Callback) const
+            {
+                return Loop.Offload(std::forward<TCallback>(Callback));
+            }
+        };
+
+        /**
+         * @brief Resumes the awaiting coroutine from the time wheel
+         * after the given duration, rounded up to whole ticks
+         */
+        struct SleepAwaiter
+        {
+            EventLoop &Loop;
+            Duration Timeout;
+
+            inline bool await_ready() const noexcept
+            {
+                return Timeout.AsMilliseconds() <= 0;
+            }
+
+            void await_suspend(std::coroutine_handle<> Handle)
+            {
+                Loop.AssertPermission();
+
+                size_t Length = Timeout.AsMilliseconds();
+                size_t Interval = std::max<size_t>(Loop.Wheel.Interval().AsMilliseconds(), 1);
+                size_t Steps = (Length + Interval - 1) / Interval;
+
+                Loop.Wheel.Add(Steps, [Handle]
+                               { Handle.resume(); });
+            }
+
+            inline void await_resume() const noexcept {}
+        };
+
+        /**
+         * @brief Runs a callback on the target loop and resumes the
+         * awaiting coroutine on the loop it was suspended from.
+         * The awaiter itself is the queued node so nothing is allocated.
+         */
+        template <typename TCallback>
+        struct CallAwaiter : public ActionQueue::Node
+        {
+            using TResult = std::invoke_result_t<TCallback &>;
+
+            struct Empty
+            {
+            };
+
+            EventLoop &Target;
+            TCallback Callback;
+            EventLoop *Origin = nullptr;
+            std::coroutine_handle<> Handle = nullptr;
+            std::exception_ptr Error = nullptr;
+            std::conditional_t<std::is_void_v<TResult>, Empty, std::optional<TResult>> Result;
+
+            template <typename T>
+            CallAwaiter(EventLoop &target, T &&callback) : Target(target), Callback(std::forward<T>(callback)) {}
+
+            inline bool await_ready() const
+            {
+                return Target.HasPermission();
+            }
+
+            void await_suspend(std::coroutine_handle<> handle)
+            {
+                Handle = handle;
+                Origin = EventLoop::Current();
+                Invoke = &CallAwaiter::Run;
+
+                Target.Post(this);
+            }
+
+            TResult await_resume()
+            {
+                // Target was the current loop, run inline
+
+                if (!Handle)
+                    return Callback();
+
+                if (Error)
+                    std::rethrow_exception(Error);
+
+                if constexpr (!std::is_void_v<TResult>)
+                    return std::move(*Result);
+            }
+
+        private:
+            static void Run(ActionQueue::Node *Self, bool Execute)
+            {
+                auto &Item = *static_cast<CallAwaiter *>(Self);
+
+                if (!Execute)
+                {
+                    Item.Handle.destroy();
+                    return;
+                }
+
+                try
+                {
+                    if constexpr (std::is_void_v<TResult>)
+                        Item.Callback();
+                    else
+                        Item.Result.emplace(Item.Callback());
+                }
+                catch (...)
+                {
+                    Item.Error = std::current_exception();
+                }
+
+                if (Item.Origin && Item.Origin != &Item.Target)
+                {
+                    Item.Invoke = &CallAwaiter::Resume;
+                    Item.Origin->Post(&Item);
+                }
+                else
+                {
+                    Item.Handle.resume();
+                }
+            }
+
+            static void Resume(ActionQueue::Node *Self, bool Execute)
+            {
+                auto &Item = *static_cast<CallAwaiter *>(Self);
+
+                if (Execute)
+                    Item.Handle.resume();
+                else
+                    Item.Handle.destroy();
+            }
         };
 
         EventLoop() = default;
         EventLoop(EventLoop const &Other) = delete;
-        EventLoop(EventLoop &&Other) noexcept : _Poll(std::move(Other._Poll)), Expire(std::move(Other.Expire)), Interrupt(std::move(Other.Interrupt)), Wheel(std::move(Other.Wheel)), Handlers(std::move(Other.Handlers)), Actions(std::move(Other.Actions)) {}
+        EventLoop(EventLoop &&Other) noexcept : _Poll(std::move(Other._Poll)), Expire(std::move(Other.Expire)), Wake(Other.Wake), Wheel(std::move(Other.Wheel)), Handlers(std::move(Other.Handlers)), Actions(std::move(Other.Actions)), _Tickless(Other._Tickless), SpinBudget(Other.SpinBudget), _BusyPoll(Other._BusyPoll), EventsLimit(Other.EventsLimit), _Compute(Other._Compute) {}
 
-        EventLoop(Duration const &Interval) : _Poll(0), Expire(nullptr), Interrupt(nullptr), Wheel(Interval)
+        EventLoop(Duration const &Interval, Backends Kind = DefaultBackend) : _Poll(Kind), Expire(nullptr), Wheel(Interval)
         {
-            auto IIterator = Insert(
+            auto IId = Insert(
                 Event(0, 0),
                 [](EventLoop::Context &Context, ePoll::Entry &)
                 {
@@ -130,44 +530,86 @@ namespace Core::Async
 
                     ev.Listen();
 
-                    {
-                        // @todo Potential bottle neck
-
-                        std::unique_lock lock(Context.Loop.QueueMutex);
+                    // Clear the flag before draining so a producer racing with
+                    // us either lands in this batch or signals a new wakeup
 
-                        Context.Loop.Actions.ForEach(
-                            [](auto &CB)
-                            {
-                                CB();
-                            });
+                    Context.Loop.WakePending.store(false, std::memory_order_seq_cst);
 
-                        Context.Loop.Actions.Free();
-                    }
+#ifdef COREKIT_METRICS
+                    Context.Loop.Stats.Wakeup(Context.Loop.Actions.Run());
+#else
+                    Context.Loop.Actions.Run();
+#endif
                 },
                 nullptr,
                 {0, 0});
 
             // Assign interrupt event
 
-            Interrupt = static_cast<Event *>(&IIterator->File);
+            Wake = Handlers[IId].File.INode();
 
             // Add expire event
 
-            auto TIterator = Insert(
-                Timer(Timer::Monotonic, 0),
+            auto TId = Insert(
+                Timer(Timer::Monotonic, Timer::NonBlocking),
                 [](EventLoop::Context &Context, ePoll::Entry &)
                 {
-                    auto &Ev = *static_cast<Event *>(&Context.Self.File);
+                    auto &Ev = *static_cast<Timer *>(&Context.Self.File);
+
+                    uint64_t Count = 0;
+
+                    // Non-blocking since re-arming a one-shot timer resets its count
 
-                    Ev.Listen();
-                    Context.Loop.Wheel.Tick();
+                    Ev.Read(&Count, sizeof Count);
+
+#ifdef COREKIT_METRICS
+                    Context.Loop.Lagged(Count);
+#endif
+
+                    // Tickless loops catch up right after every wait instead
+
+                    if (!Context.Loop._Tickless)
+                        Context.Loop.Wheel.Advance(Count);
                 },
                 nullptr,
                 {0, 0});
 
             // Assign expire event
 
-            Expire = static_cast<Timer *>(&TIterator->File);
+            Expire = static_cast<Timer *>(&Handlers[TId].File);
+        }
+
+        /**
+         * @brief Reallocates the handler slab and the poll backend from the
+         * calling thread, so a runner bound to a NUMA node gets its loop's
+         * storage from that node. Call on the runner before the loop starts
+         */
+        void Relocate()
+        {
+            Handle TId;
+
+            Handlers.ForEach(
+                [&](Entry &Self)
+                {
+                    if (&Self.File == Expire)
+                        TId = Self.Id;
+                });
+
+            Handlers.Relocate();
+
+            Expire = static_cast<Timer *>(&Handlers[TId].File);
+
+            // Nothing was waited for yet so every registration is carried over as is
+
+            PollType Local(_Poll.Kind());
+
+            Handlers.ForEach(
+                [&](Entry &Self)
+                {
+                    Local.Add(Self.File, Self.Events, Self.Id.Pack());
+                });
+
+            _Poll = std::move(Local);
         }
 
         inline bool HasPermission() const
@@ -200,82 +642,200 @@ namespace Core::Async
             return Wheel.Add(Interval, std::move(Callback));
         }
 
+        /**
+         * @brief Pushes the entry's idle timeout back
+         * Only the deadline is recorded, the wheel is touched when the
+         * timeout moves earlier and otherwise the expiry callback re-arms
+         * itself for the remaining time.
+         */
         void Reschedule(Entry &Self, Duration const &Interval)
         {
-            Self.Timer = Reschedule(Self.Timer, Interval);
+            AssertPermission();
+
+            size_t Timeout = Interval.AsMilliseconds();
+
+            if (Self.Timer == Wheel.end())
+            {
+                if (Timeout)
+                    Expiration(Self, Timeout);
+
+                return;
+            }
+
+            Self.Deadline = _Now + Timeout;
+
+            if (Self.Deadline < Self.Expiry)
+            {
+                Wheel.Remove(Self.Timer);
+                Expiration(Self, Timeout);
+            }
+        }
+
+        /**
+         * @brief Monotonic milliseconds cached once per loop iteration
+         */
+        inline size_t Now() const
+        {
+            return _Now;
         }
 
         /**
          * @brief Only removes the connection handler
-         * @param Iterator
+         * @param Id Handle of the entry, ignored if stale
          */
-        void RemoveHandler(Container::iterator Iterator)
+        void RemoveHandler(Handle Id)
         {
             AssertPermission();
 
-            if (Iterator->End)
+            Entry *Self = Handlers.Find(Id);
+
+            if (!Self)
+                return;
+
+            if (Self->End)
             {
-                Iterator->End();
+                Self->End();
             }
 
-            _Poll.Delete(Iterator->File);
-            Handlers.erase(Iterator);
+            bool Counted = Self->Counted;
+
+            _Poll.Delete(Self->File);
+            Handlers.Remove(Id);
+
+            if (Counted)
+                Load.fetch_sub(1, std::memory_order_relaxed);
         }
 
-        void RemoveTimer(Container::iterator Iterator)
+        void RemoveTimer(Handle Id)
         {
             AssertPermission();
 
-            Wheel.Remove(Iterator->Timer);
+            if (Entry *Self = Handlers.Find(Id))
+                Wheel.Remove(Self->Timer);
         }
 
-        void Remove(Container::iterator Iterator)
+        void Remove(Handle Id)
         {
-            Wheel.Remove(Iterator->Timer);
-            RemoveHandler(Iterator);
+            if (Entry *Self = Handlers.Find(Id))
+                Wheel.Remove(Self->Timer);
+
+            RemoveHandler(Id);
         }
 
-        void Modify(Entry &Self, ePoll::Event Events)
+        inline Entry *Find(Handle Id)
         {
-            _Poll.Modify(Self.File, Events, (size_t)&Self);
+            return Handlers.Find(Id);
         }
 
-        template <typename TCallback>
-        void Enqueue(TCallback &&Callback)
+        /**
+         * @brief Registers a descriptor from the loop's own thread
+         * @return Handle of the new entry
+         */
+        Handle Attach(Descriptor &&File, CallbackType &&Callback, EndCallbackType &&End = nullptr, Duration const &Interval = {0, 0}, ePoll::Event Events = ePoll::In)
         {
-            {
-                using namespace std::placeholders;
+            AssertPermission();
 
-                std::unique_lock lock(QueueMutex);
+            auto Id = Insert(std::move(File), std::move(Callback), std::move(End), Interval, Events);
 
-                Actions.Add(std::forward<TCallback>(Callback));
-            }
+            Load.fetch_add(1, std::memory_order_relaxed);
 
-            Notify();
+            return Id;
         }
 
-        template <typename TCallback, typename... TArgs>
-        void Execute(TCallback &&Callback, TArgs &&...Args)
+        /**
+         * @brief Changes the entry's interest, a no-op if it's unchanged
+         * except for one-shot entries which are re-armed by every call
+         */
+        void Modify(Entry &Self, ePoll::Event Events)
         {
-            if (HasPermission())
-            {
-                Callback(std::forward<TArgs>(Args)...);
-            }
-            else
-            {
-                // @todo maybe use lock free queue?
+            if (Self.Events == Events && !(Events & ePoll::OneShot))
+                return;
 
-                {
-                    using namespace std::placeholders;
+            Self.Events = Events;
 
-                    std::unique_lock lock(QueueMutex);
+            _Poll.Modify(Self.File, Events, Self.Id.Pack());
+        }
 
-                    Actions.Add(
-                        [Callback = std::forward<TCallback>(Callback), ... Args = std::forward<TArgs>(Args)]() mutable
-                        {
-                            Callback(std::forward<TArgs>(Args)...);
-                        });
-                }
+        /**
+         * @brief Queues an intrusive node, the caller keeps ownership
+         * and its Invoke is called once with the run or drop decision
+         */
+        void Post(ActionQueue::Node *Item)
+        {
+            Actions.Push(Item);
+
+            Notify();
+        }
+
+        inline SleepAwaiter Sleep(Duration const &Timeout)
+        {
+            return {*this, Timeout};
+        }
+
+        /**
+         * @brief Awaitable version of Execute
+         * Usage : auto Result = co_await Other.Call([]{ return 1; });
+         */
+        template <typename TCallback>
+        inline CallAwaiter<std::decay_t<TCallback>> Call(TCallback &&Callback)
+        {
+            return {*this, std::forward<TCallback>(Callback)};
+        }
+
+        /**
+         * @brief Executor CPU bound work offloaded from this loop runs on,
+         * the shared one if none is set. Requires Async/Executor.hpp
+         */
+        inline void Compute(Executor &Pool)
+        {
+            _Compute = &Pool;
+        }
+
+        inline Executor *Compute() const
+        {
+            return _Compute;
+        }
+
+        /**
+         * @brief Runs a callback on the loop's executor, the result comes
+         * back to this loop through Then or co_await. Requires Async/Executor.hpp
+         */
+        template <typename TCallback>
+        inline Offloaded<std::decay_t<TCallback>> Offload(TCallback &&Callback)
+        {
+            return {*this, std::forward<TCallback>(Callback)};
+        }
+
+        /**
+         * @brief Loop running on the calling thread, if any
+         */
+        static inline EventLoop *Current()
+        {
+            return Active;
+        }
+
+        template <typename TCallback>
+        void Enqueue(TCallback &&Callback)
+        {
+            Actions.Add(std::forward<TCallback>(Callback));
+
+            Notify();
+        }
+
+        template <typename TCallback, typename... TArgs>
+        void Execute(TCallback &&Callback, TArgs &&...Args)
+        {
+            if (HasPermission())
+            {
+                Callback(std::forward<TArgs>(Args)...);
+            }
+            else
+            {
+                Actions.Add(
+                    [Callback = std::forward<TCallback>(Callback), ... Args = std::forward<TArgs>(Args)]() mutable
+                    {
+                        Callback(std::forward<TArgs>(Args)...);
+                    });
 
                 Notify();
             }
@@ -283,51 +843,362 @@ namespace Core::Async
 
         void Assign(Descriptor &&Client, CallbackType &&Callback, EndCallbackType &&End = nullptr, Duration const &Interval = {0, 0}, ePoll::Event Events = ePoll::In)
         {
+            // Counted right away so dispatchers see connections still in flight,
+            // and uncounted if the insertion fails
+
+            Load.fetch_add(1, std::memory_order_relaxed);
+
             Execute(
                 [this, Events](Descriptor &&c, CallbackType &&cb, EndCallbackType &&ecb, Duration const &to) mutable
                 {
-                    Insert(std::move(c), std::move(cb), std::move(ecb), to, Events);
+                    try
+                    {
+                        Prepare(c);
+                        Insert(std::move(c), std::move(cb), std::move(ecb), to, Events);
+                    }
+                    catch (...)
+                    {
+                        Load.fetch_sub(1, std::memory_order_relaxed);
+                        throw;
+                    }
                 },
                 std::move(Client), std::move(Callback), std::move(End), Interval);
         }
 
+        /**
+         * @brief Assigns a listening socket, which isn't counted in Connections
+         * so dispatchers only weigh the connections a loop serves
+         */
+        void AssignListener(Descriptor &&Listener, CallbackType &&Callback, EndCallbackType &&End = nullptr, ePoll::Event Events = ePoll::In)
+        {
+            Execute(
+                [this, Events](Descriptor &&l, CallbackType &&cb, EndCallbackType &&ecb) mutable
+                {
+                    Prepare(l);
+                    Handlers[Insert(std::move(l), std::move(cb), std::move(ecb), {0, 0}, Events)].Counted = false;
+                },
+                std::move(Listener), std::move(Callback), std::move(End));
+        }
+
+        /**
+         * @brief Assigns several descriptors with a single hop to the loop's thread
+         */
+        void Assign(Iterable::List<Assignment> &&Batch, Duration const &Interval = {0, 0}, ePoll::Event Events = ePoll::In)
+        {
+            Load.fetch_add(Batch.Length(), std::memory_order_relaxed);
+
+            Execute(
+                [this, Events](Iterable::List<Assignment> &&b, Duration const &to) mutable
+                {
+                    size_t Inserted = 0;
+
+                    try
+                    {
+                        b.ForEach(
+                            [this, Events, &to, &Inserted](Assignment &Item)
+                            {
+                                Prepare(Item.File);
+                                Insert(std::move(Item.File), std::move(Item.Callback), std::move(Item.End), to, Events);
+                                Inserted++;
+                            });
+                    }
+                    catch (...)
+                    {
+                        // The failed descriptor and the ones behind it are dropped
+
+                        Load.fetch_sub(b.Length() - Inserted, std::memory_order_relaxed);
+                        throw;
+                    }
+                },
+                std::move(Batch), Interval);
+        }
+
         void Upgrade(Entry &Self, CallbackType &&Callback, Duration const &Interval = {0, 0}, ePoll::Event Events = ePoll::In)
         {
             Execute(
-                [this, Events](Container::iterator si, CallbackType &&cb, Duration const &to) mutable
+                [this, Events](Handle si, CallbackType &&cb, Duration const &to) mutable
                 {
                     Insert(si, std::move(cb), to, Events);
                 },
-                Self.Iterator, std::move(Callback), Interval);
+                Self.Id, std::move(Callback), Interval);
         }
 
+        /**
+         * @brief Wakes the loop up, signals the interrupt event only
+         * on the transition from idle to pending
+         */
         void Notify(uint64_t Value = 1)
         {
-            Interrupt->Emit(Value);
+            if (WakePending.exchange(true, std::memory_order_seq_cst))
+            {
+                Suppressed.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            Sent.fetch_add(1, std::memory_order_relaxed);
+
+            // Written by descriptor number since the interrupt entry moves when the loop relocates
+
+            if (write(Wake, &Value, sizeof Value) < 0)
+                throw std::system_error(errno, std::generic_category());
+        }
+
+        inline uint64_t WakeupsSent() const
+        {
+            return Sent.load(std::memory_order_relaxed);
+        }
+
+        inline uint64_t WakeupsSuppressed() const
+        {
+            return Suppressed.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Descriptors assigned or attached to this loop, safe from any thread
+         */
+        inline size_t Connections() const
+        {
+            return Load.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Smoothed delay in microseconds from a wakeup to the dispatch
+         * of the last event it returned, how long ready events queue behind
+         * each other's callbacks. Safe from any thread
+         */
+        inline uint64_t Lag() const
+        {
+            return Delay.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Backend the loop was constructed with
+         */
+        inline Backends Backend() const
+        {
+            return _Poll.Kind();
+        }
+
+        /**
+         * @brief In tickless mode the expire timer is armed one-shot for
+         * the wheel's next deadline instead of firing every interval,
+         * so an idle loop doesn't wake up at all.
+         * Must be set before the loop starts running.
+         */
+        inline void Tickless(bool Value)
+        {
+            _Tickless = Value;
+        }
+
+        inline bool IsTickless() const
+        {
+            return _Tickless;
+        }
+
+        /**
+         * @brief Polls without blocking for up to Budget before every blocking
+         * wait, trading CPU time for wakeup latency. A zero budget turns it off.
+         * With BusyPoll descriptors assigned to this loop also get SO_BUSY_POLL
+         * and SO_PREFER_BUSY_POLL so the kernel polls the device queue for them.
+         * Must be set before the loop starts running.
+         */
+        inline void Spin(Duration const &Budget, bool BusyPoll = false)
+        {
+            SpinBudget = Budget.AsMicroseconds() > 0 ? Budget.AsMicroseconds() : 0;
+            _BusyPoll = BusyPoll && SpinBudget;
+        }
+
+        inline bool IsSpinning() const
+        {
+            return SpinBudget != 0;
+        }
+
+        /**
+         * @brief Most events taken per wait, the batch starts small and
+         * doubles whenever a wait fills it up to this limit
+         */
+        inline void MaxEvents(size_t Count)
+        {
+            EventsLimit = Count;
+        }
+
+        inline size_t MaxEvents() const
+        {
+            return EventsLimit;
+        }
+
+        /**
+         * @brief Total microseconds spent spinning on empty polls, safe from any thread
+         */
+        inline uint64_t SpinTime() const
+        {
+            return Spun.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Total microseconds spent handling events, safe from any thread
+         */
+        inline uint64_t WorkTime() const
+        {
+            return Worked.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief What the loop was last seen doing, Count moves on with every
+         * dispatched callback and every wait so a Count that stays the same
+         * while not Waiting means one callback is still running
+         */
+        struct Pulse
+        {
+            uint64_t Count = 0;
+            Entry const *Self = nullptr; // Entry being dispatched, null for the loop's own work
+            bool Waiting = true;
+        };
+
+        /**
+         * @brief Latest heartbeat, safe from any thread. Always Waiting when
+         * built with COREKIT_NO_HEARTBEAT
+         */
+        inline Pulse Heartbeat() const
+        {
+            uint64_t Count = Beats.load(std::memory_order_acquire);
+            uintptr_t Current = Running.load(std::memory_order_relaxed);
+
+            return {Count, Current >= Internal ? nullptr : reinterpret_cast<Entry const *>(Current), Current == Idle};
+        }
+
+        /**
+         * @brief Thread the loop last ran on, valid once its heartbeat left Waiting
+         */
+        inline pthread_t NativeThread() const
+        {
+            return Native.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Copy of the loop's metrics, safe from any thread
+         * Empty unless built with COREKIT_METRICS
+         */
+        inline LoopMetrics::Snapshot Metrics() const
+        {
+#ifdef COREKIT_METRICS
+            return Stats.Take();
+#else
+            return {};
+#endif
         }
 
         template <typename TCallback>
         void Loop(TCallback Condition)
         {
             auto duration = Wheel.Interval();
+            bool Ring = _Poll.Kind() == Backends::uRing;
 
-            Expire->Set(duration, duration);
+            _Now = Monotonic() / 1000;
 
-            ePoll::List Events(Handlers.size() ? Handlers.size() : 1);
+            // Ring timeouts bound every wait so the expire timer stays unarmed
+
+            if (_Tickless || Ring)
+            {
+                Anchor = _Now;
+                Armed = 0;
+            }
+            else
+            {
+                Expire->Set(duration, duration);
+
+#ifdef COREKIT_METRICS
+                Due = Monotonic() + duration.AsMicroseconds();
+#endif
+            }
+
+            ePoll::List Events(std::clamp(Handlers.Length(), MinBatch, std::max(EventsLimit, MinBatch)));
+
+            EventLoop *Previous = std::exchange(Active, this);
+
+            Native.store(pthread_self(), std::memory_order_relaxed);
 
             while (Condition())
             {
-                _Poll(Events);
+                int Timeout = _Tickless || Ring ? Arm() : -1;
+
+                if (Started)
+                {
+                    // Time spent handling the last batch
+
+                    Worked.store(Worked.load(std::memory_order_relaxed) + (Monotonic() - Started), std::memory_order_relaxed);
+                }
+
+#ifdef COREKIT_METRICS
+                size_t Waiting = Monotonic();
+#endif
+
+                Beat(Idle);
+
+                Wait(Events, Timeout);
+
+                Beat(Internal);
+
+                Started = Monotonic();
+                _Now = Started / 1000;
+
+#ifdef COREKIT_METRICS
+                // No expire timer fires on the ring so the lag is taken once the deadline passed
+
+                if (Ring && Due && Started >= Due)
+                    Lagged(1);
+#endif
+
+#ifdef COREKIT_METRICS
+                Stats.Wait(Events.Length(), Started - Waiting);
+#endif
+
+                if (_Tickless || Ring)
+                    CatchUp();
+
+                size_t Pending = Events.Length();
 
                 Events.ForEach(
-                    [this](ePoll::Entry &Item)
+                    [this, &Pending](ePoll::Entry &Item)
                     {
-                        EventLoop::Context Context{*this, *reinterpret_cast<Entry *>(Item.Data)};
+                        // The batch's last event waited the longest since the wakeup
+
+                        if (!--Pending)
+                            Delayed(Monotonic() - Started);
+
+                        Entry *Self = Handlers.Find(Handle::Unpack(Item.Data));
+
+                        // Slot was released or recycled since the wait returned
+
+                        if (!Self)
+                            return;
+
+                        EventLoop::Context Context{*this, *Self};
 
+                        Beat(reinterpret_cast<uintptr_t>(Self));
+
+#ifdef COREKIT_METRICS
+                        size_t Begin = Monotonic();
+
+                        Context.Self.Callback(Context, Item);
+
+                        Stats.Callback(Monotonic() - Begin);
+#else
                         Context.Self.Callback(Context, Item);
+#endif
                     });
+
+#ifdef COREKIT_METRICS
+                Stats.Syscalls(_Poll.Syscalls());
+#endif
+
+                Adapt(Events);
             }
 
+            Active = Previous;
+
+            Beat(Idle);
+
             Expire->Stop();
         }
 
@@ -338,96 +1209,402 @@ namespace Core::Async
             {
                 _Poll = std::move(Other._Poll);
                 Expire = std::move(Other.Expire);
-                Interrupt = std::move(Other.Interrupt);
+                Wake = Other.Wake;
                 Wheel = std::move(Other.Wheel);
                 Handlers = std::move(Other.Handlers);
                 Actions = std::move(Other.Actions);
+                _Tickless = Other._Tickless;
+                SpinBudget = Other.SpinBudget;
+                _BusyPoll = Other._BusyPoll;
+                EventsLimit = Other.EventsLimit;
+                _Compute = Other._Compute;
             }
 
             return *this;
         }
 
     private:
-        Container::iterator Insert(Descriptor &&descriptor, CallbackType &&handler, EndCallbackType &&end, Duration const &Timeout, ePoll::Event Events = ePoll::In)
+        /**
+         * @brief Monotonic clock in microseconds
+         */
+        static inline size_t Monotonic()
         {
-            auto Iterator = Handlers.insert(Handlers.end(), {std::move(descriptor), std::move(handler), std::move(end), Handlers.end(), Wheel.end()});
-            Iterator->Iterator = Iterator;
+            timespec Now;
 
-            if (Timeout.AsMilliseconds() > 0)
+            clock_gettime(CLOCK_MONOTONIC, &Now);
+
+            return Now.tv_sec * 1000000 + Now.tv_nsec / 1000;
+        }
+
+        /**
+         * @brief Smooths the wakeup to dispatch delay over about 8 batches
+         */
+        inline void Delayed(uint64_t Sample)
+        {
+            uint64_t Previous = Delay.load(std::memory_order_relaxed);
+
+            Delay.store(Previous - Previous / 8 + Sample / 8, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Publishes what the loop is about to do for watchdogs, the
+         * entry's address and a new count as plain stores since only this
+         * thread writes the heartbeat. What the entry holds is only read by a
+         * watchdog once it reports a stall
+         */
+        inline void Beat([[maybe_unused]] uintptr_t Current)
+        {
+#ifndef COREKIT_NO_HEARTBEAT
+            Running.store(Current, std::memory_order_relaxed);
+            Beats.store(Beats.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+#endif
+        }
+
+        /**
+         * @brief Spins on non-blocking polls until events show up or the
+         * budget runs out, then falls back to a blocking wait
+         * @param Timeout Milliseconds the blocking wait may last, -1 for none
+         */
+        void Wait(ePoll::List &Events, int Timeout = -1)
+        {
+            if (SpinBudget)
             {
-                Iterator->Timer = Wheel.Add(
-                    Timeout,
-                    [this, Iterator]
-                    {
-                        // Remove(Iterator);
-
-                        /**
-                         * @brief Important note
-                         * Remove cannot be used here
-                         * because this function is called on time out
-                         * event in which an iterator will loop through
-                         * the list's entries and clean it.
-                         * Calling normal Remove will cause the iterator itself
-                         * to be removed in between iterating through that list
-                         * and will cause segmentation fault.
-                         * RemoveHandler in turn, will only remove the descriptor
-                         * and its handler but not the time-out entry inside our
-                         * time wheel object so after executing this callback,
-                         * the time wheel handles the task of cleaning the time-out
-                         * handler and iterator itself.
-                         */
-                        RemoveHandler(Iterator);
-                    });
+                size_t Start = Monotonic();
+                size_t Now = Start;
+
+                do
+                {
+                    _Poll(Events, 0);
+
+                    if (Events.Length())
+                        break;
+
+                    Now = Monotonic();
+                } while (Now - Start < SpinBudget);
+
+                Spun.store(Spun.load(std::memory_order_relaxed) + (Now - Start), std::memory_order_relaxed);
+
+                if (Events.Length())
+                    return;
+            }
+
+            _Poll(Events, Timeout);
+        }
+
+        /**
+         * @brief Grows the event batch when a wait fills it and shrinks
+         * it after a run of waits that used less than a quarter of it
+         */
+        void Adapt(ePoll::List &Events)
+        {
+            size_t Count = Events.Length();
+            size_t Capacity = Events.Capacity();
+            size_t Limit = std::max(EventsLimit, MinBatch);
+            size_t Size = Capacity;
+
+            if (Count == Capacity && Capacity < Limit)
+            {
+                Size = std::min(Capacity * 2, Limit);
+            }
+            else if (Capacity > Limit)
+            {
+                Size = Limit;
+            }
+            else if (Capacity > MinBatch && Count < Capacity / 4)
+            {
+                if (++Quiet >= ShrinkAfter)
+                    Size = std::max(Capacity / 2, MinBatch);
             }
             else
             {
-                Iterator->Timer = Wheel.At(0, 0).Entries.end();
+                Quiet = 0;
+            }
+
+            if (Size == Capacity)
+                return;
+
+            Quiet = 0;
+
+            Events.Length(0);
+            Events.Resize(Size);
+        }
+
+        /**
+         * @brief Applies the loop's busy polling to an assigned descriptor
+         * Best effort since budgets above net.core.busy_read need CAP_NET_ADMIN
+         */
+        void Prepare(Descriptor &File)
+        {
+            if (!_BusyPoll)
+                return;
+
+            int Budget = static_cast<int>(SpinBudget);
+            int Prefer = 1;
+
+            setsockopt(File.INode(), SOL_SOCKET, SO_BUSY_POLL, &Budget, sizeof(Budget));
+            setsockopt(File.INode(), SOL_SOCKET, SO_PREFER_BUSY_POLL, &Prefer, sizeof(Prefer));
+        }
+
+        /**
+         * @brief Points the expire timer at the wheel's next deadline,
+         * only touching the timer when that deadline changes
+         * @return Milliseconds the next wait may block for, the io_uring
+         * backend bounds the wait with a ring timeout instead of the timer,
+         * up to the next tick unless the loop is tickless
+         */
+        int Arm()
+        {
+            size_t Ticks = _Tickless ? Wheel.NextDeadline() : 1;
+
+            if (!Ticks)
+            {
+                if (Armed)
+                {
+                    Expire->Stop();
+                    Armed = 0;
+                }
+
+                return -1;
+            }
+
+            size_t Deadline = Anchor + Ticks * Wheel.Interval().AsMilliseconds();
+
+            if (_Poll.Kind() == Backends::uRing)
+            {
+                size_t Precise = Monotonic();
+                size_t Now = Precise / 1000;
+
+#ifdef COREKIT_METRICS
+                Due = Deadline > Now ? Precise + (Deadline - Now) * 1000 : Precise;
+#endif
+
+                return Deadline > Now ? static_cast<int>(Deadline - Now) : 0;
             }
 
-            _Poll.Add(Iterator->File, Events, (size_t) & *Iterator);
+            if (Deadline == Armed)
+                return -1;
+
+            size_t Precise = Monotonic();
+            size_t Now = Precise / 1000;
+
+            Expire->Set(Deadline > Now ? Duration::FromMilliseconds(Deadline - Now) : Duration(0, 1));
+            Armed = Deadline;
 
-            return Iterator;
+#ifdef COREKIT_METRICS
+            Due = Deadline > Now ? Precise + (Deadline - Now) * 1000 : Precise;
+#endif
+
+            return -1;
         }
 
-        Container::iterator Insert(Container::iterator Item, CallbackType &&handler, Duration const &Timeout, ePoll::Event Events = ePoll::In)
+#ifdef COREKIT_METRICS
+        /**
+         * @brief Records how late the expire timer ran, Count is the
+         * number of expirations read from it
+         */
+        void Lagged(uint64_t Count)
         {
-            auto Iterator = Handlers.insert(Handlers.end(), {std::move(Item->File), std::move(handler), std::move(Item->End), Handlers.end(), Wheel.end()});
-            Iterator->Iterator = Iterator;
+            if (!Count || !Due)
+                return;
+
+            size_t Now = Monotonic();
+
+            if (_Tickless || _Poll.Kind() == Backends::uRing)
+            {
+                Stats.Tick(Now > Due ? Now - Due : 0);
+                Due = 0;
+                return;
+            }
+
+            size_t Interval = Wheel.Interval().AsMicroseconds();
+            size_t Last = Due + (Count - 1) * Interval;
+
+            Stats.Tick(Now > Last ? Now - Last : 0);
+            Due = Last + Interval;
+        }
+#endif
+
+        void CatchUp()
+        {
+            size_t Interval = Wheel.Interval().AsMilliseconds();
+            size_t Ticks = (_Now - Anchor) / Interval;
+
+            if (!Ticks)
+                return;
+
+            Anchor += Ticks * Interval;
+
+            Wheel.Advance(Ticks);
+        }
+
+        void Expiration(Entry &Self, size_t Timeout)
+        {
+            Self.Deadline = Self.Expiry = _Now + Timeout;
+
+            // Timers only run inside this loop so the handle alone fits the callback's small buffer
+
+            Self.Timer = Wheel.Add(
+                Duration::FromMilliseconds(Timeout),
+                [Id = Self.Id]
+                {
+                    EventLoop::Current()->Expired(Id);
+                });
+        }
+
+        void Expired(Handle Id)
+        {
+            Entry *Self = Handlers.Find(Id);
+
+            if (!Self)
+                return;
+
+            // Activity moved the deadline since this was armed
+
+            if (Self->Deadline > _Now)
+            {
+                Expiration(*Self, Self->Deadline - _Now);
+                return;
+            }
+
+            // The wheel defers releasing the running entry so a full Remove is safe here
+
+            Remove(Id);
+        }
+
+        Handle Insert(Descriptor &&descriptor, CallbackType &&handler, EndCallbackType &&end, Duration const &Timeout, ePoll::Event Events = ePoll::In)
+        {
+            auto Id = Handlers.Add(std::move(descriptor), std::move(handler), std::move(end), Handle{}, Wheel.end());
+            auto &Self = Handlers[Id];
+
+            Self.Id = Id;
 
             if (Timeout.AsMilliseconds() > 0)
             {
-                Iterator->Timer = Wheel.Add(
-                    Timeout,
-                    [this, Iterator]
-                    {
-                        RemoveHandler(Iterator);
-                    });
+                Expiration(Self, Timeout.AsMilliseconds());
             }
-            else
+
+            Self.Events = Events;
+
+            _Poll.Add(Self.File, Events, Id.Pack());
+
+            return Id;
+        }
+
+        Handle Insert(Handle Item, CallbackType &&handler, Duration const &Timeout, ePoll::Event Events = ePoll::In)
+        {
+            Entry *Old = Handlers.Find(Item);
+
+            if (!Old)
+                return {};
+
+            auto Id = Handlers.Add(std::move(Old->File), std::move(handler), std::move(Old->End), Handle{}, Wheel.end());
+            auto &Self = Handlers[Id];
+
+            Self.Id = Id;
+            Self.Counted = Old->Counted;
+
+            if (Timeout.AsMilliseconds() > 0)
             {
-                Iterator->Timer = Wheel.At(0, 0).Entries.end();
+                Expiration(Self, Timeout.AsMilliseconds());
             }
 
-            _Poll.Modify(Iterator->File, Events, (size_t) & *Iterator);
+            Self.Events = Events;
+
+            _Poll.Modify(Self.File, Events, Id.Pack());
 
             RemoveTimer(Item);
-            Handlers.erase(Item);
+            Handlers.Remove(Item);
 
-            return Iterator;
+            return Id;
         }
 
-        ePoll _Poll;
+        PollType _Poll;
         Timer *Expire;
-        Event *Interrupt;
+        int Wake = -1;
         TimeWheelType Wheel;
         Container Handlers;
 
-        std::mutex QueueMutex;
-        Iterable::Queue<Core::Function<void()>> Actions;
+        ActionQueue Actions;
+        std::atomic_bool WakePending{false};
+        std::atomic<uint64_t> Sent{0};
+        std::atomic<uint64_t> Suppressed{0};
+
+        static inline thread_local EventLoop *Active = nullptr;
+
+        bool _Tickless = false;
+        size_t Anchor = 0;
+        size_t Armed = 0;
+        size_t _Now = 0;
+        size_t Started = 0;
+
+        std::atomic<size_t> Load{0};
+        std::atomic<uint64_t> Delay{0};
+
+        size_t SpinBudget = 0;
+        bool _BusyPoll = false;
+        std::atomic<uint64_t> Spun{0};
+
+        static constexpr size_t MinBatch = 16;
+        static constexpr size_t ShrinkAfter = 64;
+
+        size_t EventsLimit = 1024;
+        size_t Quiet = 0;
+
+        Executor *_Compute = nullptr;
+        std::atomic<uint64_t> Worked{0};
+
+#ifdef COREKIT_METRICS
+        LoopMetrics Stats;
+        size_t Due = 0;
+#endif
+
+        // Heartbeat markers for waiting and for work outside callbacks such as tickless timers
+
+        static constexpr uintptr_t Idle = ~uintptr_t(0);
+        static constexpr uintptr_t Internal = Idle - 1;
+
+        std::atomic<uint64_t> Beats{0};
+        std::atomic<uintptr_t> Running{Idle};
+        std::atomic<pthread_t> Native{};
 
     public:
         std::thread Runner;
         std::thread::id RunnerId;
         std::shared_ptr<void> Storage = nullptr;
     };
-}
\ No newline at end of file
+
+    /**
+     * @brief Groups descriptors by their target loop so each loop
+     * receives its share in one Assign
+     */
+    class AssignBatch
+    {
+    public:
+        void Add(EventLoop &Target, Descriptor &&File, EventLoop::CallbackType &&Callback, EventLoop::EndCallbackType &&End = nullptr)
+        {
+            size_t Index = 0;
+
+            while (Index < Groups.Length() && Groups[Index].first != &Target)
+                Index++;
+
+            if (Index == Groups.Length())
+                Groups.Add(&Target, Iterable::List<EventLoop::Assignment>(1));
+
+            Groups[Index].second.Add(EventLoop::Assignment{std::move(File), std::move(Callback), std::move(End)});
+        }
+
+        void Commit(Duration const &Interval = {0, 0}, ePoll::Event Events = ePoll::In)
+        {
+            Groups.ForEach(
+                [&](auto &Group)
+                {
+                    Group.first->Assign(std::move(Group.second), Interval, Events);
+                });
+
+            Groups.Free();
+        }
+
+    private:
+        Iterable::List<std::pair<EventLoop *, Iterable::List<EventLoop::Assignment>>> Groups{1};
+    };
+}
@@ -0,0 +1,549 @@
+#pragma once
+
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <optional>
+#include <exception>
+#include <coroutine>
+#include <type_traits>
+
+#include <Iterable/List.hpp>
+#include <Async/EventLoop.hpp>
+
+namespace Core::Async
+{
+    /**
+     * @brief Chase-Lev work stealing deque of queue nodes
+     * The owning worker pushes and pops at the bottom while any other
+     * thread may steal from the top. Grown rings are retired rather than
+     * freed since a thief may still be reading from them. Capacity must
+     * be a power of two.
+     */
+    class WorkDeque
+    {
+    public:
+        using Node = ActionQueue::Node;
+
+        WorkDeque(size_t Capacity = 256) : Ring(new Buffer(Capacity))
+        {
+            Retired.Add(std::unique_ptr<Buffer>(Ring.load(std::memory_order_relaxed)));
+        }
+
+        WorkDeque(WorkDeque const &Other) = delete;
+        WorkDeque &operator=(WorkDeque const &Other) = delete;
+
+        /**
+         * @brief Owner only
+         */
+        void Push(Node *Item)
+        {
+            int64_t Bottom = _Bottom.load(std::memory_order_relaxed);
+            int64_t Top = _Top.load(std::memory_order_acquire);
+            Buffer *Current = Ring.load(std::memory_order_relaxed);
+
+            if (Bottom - Top > static_cast<int64_t>(Current->Capacity) - 1)
+                Current = Grow(Current, Top, Bottom);
+
+            Current->Put(Bottom, Item);
+
+            _Bottom.store(Bottom + 1, std::memory_order_release);
+        }
+
+        /**
+         * @brief Owner only, takes the most recently pushed node
+         */
+        Node *Pop()
+        {
+            int64_t Bottom = _Bottom.load(std::memory_order_relaxed) - 1;
+            Buffer *Current = Ring.load(std::memory_order_relaxed);
+
+            _Bottom.store(Bottom, std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            int64_t Top = _Top.load(std::memory_order_relaxed);
+
+            if (Top > Bottom)
+            {
+                _Bottom.store(Bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            Node *Item = Current->Get(Bottom);
+
+            // Last item, race the thieves for it
+
+            if (Top == Bottom)
+            {
+                if (!_Top.compare_exchange_strong(Top, Top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    Item = nullptr;
+
+                _Bottom.store(Bottom + 1, std::memory_order_relaxed);
+            }
+
+            return Item;
+        }
+
+        /**
+         * @brief Any thread, takes the oldest node
+         * @return nullptr if empty or if another thread won the race
+         */
+        Node *Steal()
+        {
+            int64_t Top = _Top.load(std::memory_order_acquire);
+
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            int64_t Bottom = _Bottom.load(std::memory_order_acquire);
+
+            if (Top >= Bottom)
+                return nullptr;
+
+            Node *Item = Ring.load(std::memory_order_acquire)->Get(Top);
+
+            if (!_Top.compare_exchange_strong(Top, Top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return nullptr;
+
+            return Item;
+        }
+
+        inline bool IsEmpty() const
+        {
+            return _Top.load(std::memory_order_relaxed) >= _Bottom.load(std::memory_order_relaxed);
+        }
+
+    private:
+        struct Buffer
+        {
+            size_t Capacity;
+            std::unique_ptr<std::atomic<Node *>[]> Items;
+
+            Buffer(size_t capacity) : Capacity(capacity), Items(new std::atomic<Node *>[capacity]) {}
+
+            inline Node *Get(int64_t Index) const
+            {
+                return Items[static_cast<size_t>(Index) & (Capacity - 1)].load(std::memory_order_relaxed);
+            }
+
+            inline void Put(int64_t Index, Node *Item)
+            {
+                Items[static_cast<size_t>(Index) & (Capacity - 1)].store(Item, std::memory_order_relaxed);
+            }
+        };
+
+        alignas(64) std::atomic<int64_t> _Top{0};
+        alignas(64) std::atomic<int64_t> _Bottom{0};
+        std::atomic<Buffer *> Ring;
+        Iterable::List<std::unique_ptr<Buffer>> Retired{1};
+
+        Buffer *Grow(Buffer *Old, int64_t Top, int64_t Bottom)
+        {
+            auto Bigger = std::make_unique<Buffer>(Old->Capacity * 2);
+
+            for (int64_t i = Top; i < Bottom; i++)
+                Bigger->Put(i, Old->Get(i));
+
+            Buffer *Result = Bigger.get();
+
+            Retired.Add(std::move(Bigger));
+            Ring.store(Result, std::memory_order_release);
+
+            return Result;
+        }
+    };
+
+    /**
+     * @brief Work stealing pool for CPU bound jobs, kept apart from the I/O loops
+     * Every worker owns a Chase-Lev deque and a lock-free inbox. Jobs posted
+     * from outside the pool land in the inboxes round robin, jobs posted by a
+     * worker go to its own deque, and idle workers steal from the others, so
+     * there's no shared locked queue anywhere.
+     */
+    class Executor
+    {
+    public:
+        using Node = ActionQueue::Node;
+
+        Executor(size_t Count = std::thread::hardware_concurrency()) : _Length(Count ? Count : 1), Workers(new Worker[_Length])
+        {
+            for (size_t i = 0; i < _Length; i++)
+            {
+                Workers[i].Owner = this;
+                Workers[i].Runner = std::thread(
+                    [this, i]
+                    {
+                        Work(i);
+                    });
+            }
+        }
+
+        Executor(Executor const &Other) = delete;
+        Executor &operator=(Executor const &Other) = delete;
+
+        ~Executor()
+        {
+            Stop();
+        }
+
+        inline size_t Length() const
+        {
+            return _Length;
+        }
+
+        /**
+         * @brief Queues an intrusive node, safe from any thread. Its Invoke
+         * runs on a worker, or is called with Execute unset if the executor
+         * stops first.
+         */
+        void Submit(Node *Item)
+        {
+            if (Current && Current->Owner == this)
+                Current->Deque.Push(Item);
+            else
+                Workers[Turn.fetch_add(1, std::memory_order_relaxed) % _Length].Inbox.Push(Item);
+
+            Epoch.fetch_add(1, std::memory_order_seq_cst);
+
+            if (Idle.load(std::memory_order_seq_cst))
+                Epoch.notify_one();
+        }
+
+        template <typename TCallback>
+        void Enqueue(TCallback &&Callback)
+        {
+            Submit(new ActionQueue::Action<std::decay_t<TCallback>>(std::forward<TCallback>(Callback)));
+        }
+
+        /**
+         * @brief Joins the workers and drops the jobs left behind
+         */
+        void Stop()
+        {
+            if (Stopped.exchange(true))
+                return;
+
+            Epoch.fetch_add(1, std::memory_order_seq_cst);
+            Epoch.notify_all();
+
+            for (size_t i = 0; i < _Length; i++)
+            {
+                if (Workers[i].Runner.joinable())
+                    Workers[i].Runner.join();
+            }
+
+            for (size_t i = 0; i < _Length; i++)
+            {
+                while (Node *Item = Workers[i].Deque.Pop())
+                    Item->Invoke(Item, false);
+
+                Workers[i].Inbox.Free();
+            }
+        }
+
+        /**
+         * @brief Executor used by loops that weren't given one
+         */
+        static Executor &Shared()
+        {
+            static Executor Instance;
+            return Instance;
+        }
+
+    private:
+        struct Worker
+        {
+            Executor *Owner = nullptr;
+            WorkDeque Deque;
+            ActionQueue Inbox;
+            std::thread Runner;
+        };
+
+        size_t _Length;
+        std::unique_ptr<Worker[]> Workers;
+
+        std::atomic<size_t> Turn{0};
+        std::atomic<uint32_t> Epoch{0};
+        std::atomic<size_t> Idle{0};
+        std::atomic_bool Stopped{false};
+
+        static inline thread_local Worker *Current = nullptr;
+
+        void Work(size_t Index)
+        {
+            Current = &Workers[Index];
+
+            while (!Stopped.load(std::memory_order_relaxed))
+            {
+                Node *Item = Find(Index);
+
+                if (!Item)
+                {
+                    // Re-check after taking the epoch so a submit can't slip in unnoticed
+
+                    uint32_t Seen = Epoch.load(std::memory_order_seq_cst);
+
+                    if (!(Item = Find(Index)))
+                    {
+                        Idle.fetch_add(1, std::memory_order_seq_cst);
+
+                        if (!Stopped.load(std::memory_order_relaxed))
+                            Epoch.wait(Seen, std::memory_order_seq_cst);
+
+                        Idle.fetch_sub(1, std::memory_order_relaxed);
+                        continue;
+                    }
+                }
+
+                Item->Invoke(Item, true);
+            }
+
+            Current = nullptr;
+        }
+
+        /**
+         * @brief Own deque first, then own inbox, then the other workers'
+         * deques and inboxes starting from a rotating victim
+         */
+        Node *Find(size_t Index)
+        {
+            Worker &Self = Workers[Index];
+
+            if (Node *Item = Self.Deque.Pop())
+                return Item;
+
+            if (Node *Item = Adopt(Self.Inbox))
+                return Item;
+
+            size_t Start = Turn.load(std::memory_order_relaxed);
+
+            for (size_t i = 1; i < _Length; i++)
+            {
+                if (Node *Item = Workers[(Start + Index + i) % _Length].Deque.Steal())
+                    return Item;
+            }
+
+            for (size_t i = 1; i < _Length; i++)
+            {
+                if (Node *Item = Adopt(Workers[(Start + Index + i) % _Length].Inbox))
+                    return Item;
+            }
+
+            return nullptr;
+        }
+
+        /**
+         * @brief Moves an inbox's batch into the calling worker's deque,
+         * taking the batch is a single exchange so any worker may do it
+         */
+        Node *Adopt(ActionQueue &Inbox)
+        {
+            if (Inbox.IsEmpty())
+                return nullptr;
+
+            Node *Item = Inbox.Take();
+
+            if (!Item)
+                return nullptr;
+
+            Node *First = Item;
+
+            for (Item = Item->Next; Item;)
+            {
+                Node *Next = Item->Next;
+
+                Current->Deque.Push(Item);
+                Item = Next;
+            }
+
+            // Others can steal the rest of the batch
+
+            if (!Current->Deque.IsEmpty() && Idle.load(std::memory_order_relaxed))
+            {
+                Epoch.fetch_add(1, std::memory_order_seq_cst);
+                Epoch.notify_one();
+            }
+
+            return First;
+        }
+    };
+
+    /**
+     * @brief CPU bound callback headed for an executor, returned by Offload
+     * Usage : Context.Offload([]{ return Sign(Data); }).Then([](std::exception_ptr Error, auto Signature){ ... });
+     * Usage : auto Signature = co_await Loop.Offload([]{ return Sign(Data); });
+     * The continuation runs on the loop Offload was called on and gets what the
+     * callback threw, if anything, along with its result, which is empty then.
+     * It takes only the error for void callbacks. Nothing is thrown on the loop
+     * itself, awaiting coroutines get the exception from co_await instead.
+     */
+    template <typename TCallback>
+    class Offloaded
+    {
+    public:
+        using TResult = std::invoke_result_t<TCallback &>;
+
+        template <typename T>
+        Offloaded(EventLoop &loop, T &&callback) : Loop(loop), Callback(std::forward<T>(callback)) {}
+
+        template <typename TThen>
+        void Then(TThen &&Continuation)
+        {
+            Pool().Submit(new Job<std::decay_t<TThen>>(Loop, std::move(Callback), std::forward<TThen>(Continuation)));
+        }
+
+        // Awaitable
+
+        struct Awaiter : public ActionQueue::Node
+        {
+            struct Empty
+            {
+            };
+
+            Executor &Target;
+            TCallback Callback;
+            EventLoop *Origin = nullptr;
+            std::coroutine_handle<> Handle = nullptr;
+            std::exception_ptr Error = nullptr;
+            std::conditional_t<std::is_void_v<TResult>, Empty, std::optional<TResult>> Result;
+
+            Awaiter(Executor &target, TCallback &&callback) : Target(target), Callback(std::move(callback)) {}
+
+            inline bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<> handle)
+            {
+                Handle = handle;
+                Origin = EventLoop::Current();
+                Invoke = &Awaiter::Run;
+
+                Target.Submit(this);
+            }
+
+            TResult await_resume()
+            {
+                if (Error)
+                    std::rethrow_exception(Error);
+
+                if constexpr (!std::is_void_v<TResult>)
+                    return std::move(*Result);
+            }
+
+        private:
+            static void Run(ActionQueue::Node *Self, bool Execute)
+            {
+                auto &Item = *static_cast<Awaiter *>(Self);
+
+                if (!Execute)
+                {
+                    Item.Handle.destroy();
+                    return;
+                }
+
+                try
+                {
+                    if constexpr (std::is_void_v<TResult>)
+                        Item.Callback();
+                    else
+                        Item.Result.emplace(Item.Callback());
+                }
+                catch (...)
+                {
+                    Item.Error = std::current_exception();
+                }
+
+                if (Item.Origin)
+                {
+                    Item.Invoke = &Awaiter::Resume;
+                    Item.Origin->Post(&Item);
+                }
+                else
+                {
+                    Item.Handle.resume();
+                }
+            }
+
+            static void Resume(ActionQueue::Node *Self, bool Execute)
+            {
+                auto &Item = *static_cast<Awaiter *>(Self);
+
+                if (Execute)
+                    Item.Handle.resume();
+                else
+                    Item.Handle.destroy();
+            }
+        };
+
+        inline Awaiter operator co_await() &&
+        {
+            return {Pool(), std::move(Callback)};
+        }
+
+    private:
+        EventLoop &Loop;
+        TCallback Callback;
+
+        inline Executor &Pool()
+        {
+            return Loop.Compute() ? *Loop.Compute() : Executor::Shared();
+        }
+
+        template <typename TThen>
+        struct Job : public ActionQueue::Node
+        {
+            struct Empty
+            {
+            };
+
+            EventLoop &Origin;
+            TCallback Callback;
+            TThen Continuation;
+            std::exception_ptr Error = nullptr;
+            std::conditional_t<std::is_void_v<TResult>, Empty, std::optional<TResult>> Result;
+
+            Job(EventLoop &origin, TCallback &&callback, TThen &&continuation) : Node{nullptr, &Job::Run}, Origin(origin), Callback(std::move(callback)), Continuation(std::move(continuation)) {}
+
+            static void Run(ActionQueue::Node *Self, bool Execute)
+            {
+                auto *Item = static_cast<Job *>(Self);
+
+                if (!Execute)
+                {
+                    delete Item;
+                    return;
+                }
+
+                try
+                {
+                    if constexpr (std::is_void_v<TResult>)
+                        Item->Callback();
+                    else
+                        Item->Result.emplace(Item->Callback());
+                }
+                catch (...)
+                {
+                    Item->Error = std::current_exception();
+                }
+
+                Item->Invoke = &Job::Complete;
+                Item->Origin.Post(Item);
+            }
+
+            static void Complete(ActionQueue::Node *Self, bool Execute)
+            {
+                std::unique_ptr<Job> Item(static_cast<Job *>(Self));
+
+                if (!Execute)
+                    return;
+
+                if constexpr (std::is_void_v<TResult>)
+                    Item->Continuation(std::move(Item->Error));
+                else
+                    Item->Continuation(std::move(Item->Error), std::move(Item->Result));
+            }
+        };
+    };
+}
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+namespace Core::Async
+{
+    /**
+     * @brief Counters of a single event loop, only its own thread records
+     * and any thread may read them, so every update is a relaxed load and
+     * store instead of a read-modify-write. Recording only happens when
+     * COREKIT_METRICS is defined. All times are in microseconds.
+     */
+    class LoopMetrics
+    {
+    public:
+        /**
+         * @brief Callback durations are counted in power of two buckets,
+         * bucket 0 holds callbacks under 1us and bucket i those in [2^(i-1), 2^i)
+         */
+        static constexpr size_t Buckets = 24;
+
+        struct Snapshot
+        {
+            uint64_t Waits = 0;
+            uint64_t Events = 0;
+            uint64_t MaxEvents = 0;
+            uint64_t Blocked = 0;
+            uint64_t Handling = 0;
+            uint64_t Ticks = 0;
+            uint64_t Lag = 0;
+            uint64_t MaxLag = 0;
+            uint64_t Wakeups = 0;
+            uint64_t Actions = 0;
+            uint64_t MaxActionsPerWakeup = 0;
+            uint64_t Syscalls = 0;
+            uint64_t Callbacks[Buckets] = {};
+
+            inline double EventsPerWait() const
+            {
+                return Waits ? static_cast<double>(Events) / Waits : 0;
+            }
+
+            /**
+             * @brief Share of the measured time spent in callbacks
+             */
+            inline double Utilization() const
+            {
+                return Blocked + Handling ? static_cast<double>(Handling) / (Blocked + Handling) : 0;
+            }
+
+            inline double AverageLag() const
+            {
+                return Ticks ? static_cast<double>(Lag) / Ticks : 0;
+            }
+
+            /**
+             * @brief Actions each wakeup ran, the backlog found at wakeup
+             * rather than the queue depth at the time of posting
+             */
+            inline double ActionsPerWakeup() const
+            {
+                return Wakeups ? static_cast<double>(Actions) / Wakeups : 0;
+            }
+
+            /**
+             * @brief Upper bound of the bucket holding the given quantile of callback durations
+             * @param Quantile Between 0 and 1
+             */
+            inline uint64_t CallbackPercentile(double Quantile) const
+            {
+                uint64_t Total = 0;
+
+                for (auto Count : Callbacks)
+                    Total += Count;
+
+                if (!Total)
+                    return 0;
+
+                uint64_t Rank = static_cast<uint64_t>(Quantile * Total);
+                uint64_t Seen = 0;
+
+                for (size_t i = 0; i < Buckets; i++)
+                {
+                    Seen += Callbacks[i];
+
+                    if (Seen > Rank)
+                        return uint64_t(1) << i;
+                }
+
+                return uint64_t(1) << (Buckets - 1);
+            }
+
+            Snapshot &operator+=(Snapshot const &Other)
+            {
+                Waits += Other.Waits;
+                Events += Other.Events;
+                MaxEvents = std::max(MaxEvents, Other.MaxEvents);
+                Blocked += Other.Blocked;
+                Handling += Other.Handling;
+                Ticks += Other.Ticks;
+                Lag += Other.Lag;
+                MaxLag = std::max(MaxLag, Other.MaxLag);
+                Wakeups += Other.Wakeups;
+                Actions += Other.Actions;
+                MaxActionsPerWakeup = std::max(MaxActionsPerWakeup, Other.MaxActionsPerWakeup);
+                Syscalls += Other.Syscalls;
+
+                for (size_t i = 0; i < Buckets; i++)
+                    Callbacks[i] += Other.Callbacks[i];
+
+                return *this;
+            }
+        };
+
+        LoopMetrics() = default;
+        LoopMetrics(LoopMetrics const &Other) = delete;
+
+        LoopMetrics &operator=(LoopMetrics const &Other) = delete;
+
+        /**
+         * @brief A wait that blocked or spun for Time and returned Count events
+         */
+        inline void Wait(size_t Count, uint64_t Time)
+        {
+            Add(Waits, 1);
+            Add(Events, Count);
+            Max(MaxEvents, Count);
+            Add(Blocked, Time);
+        }
+
+        inline void Callback(uint64_t Time)
+        {
+            Add(Handling, Time);
+            Add(Callbacks[std::min<size_t>(std::bit_width(Time), Buckets - 1)], 1);
+        }
+
+        /**
+         * @brief The expire timer ran Time after it was due
+         */
+        inline void Tick(uint64_t Time)
+        {
+            Add(Ticks, 1);
+            Add(Lag, Time);
+            Max(MaxLag, Time);
+        }
+
+        /**
+         * @brief A wakeup ran Count queued actions, everything posted
+         * since the previous wakeup so not the depth seen by each Post
+         */
+        inline void Wakeup(size_t Count)
+        {
+            Add(Wakeups, 1);
+            Add(Actions, Count);
+            Max(MaxActionsPerWakeup, Count);
+        }
+
+        /**
+         * @brief Total syscalls the readiness backend made so far, waits and
+         * interest changes but not the reads and writes of the callbacks
+         */
+        inline void Syscalls(uint64_t Total)
+        {
+            Calls.store(Total, std::memory_order_relaxed);
+        }
+
+        Snapshot Take() const
+        {
+            Snapshot Result;
+
+            Result.Waits = Waits.load(std::memory_order_relaxed);
+            Result.Events = Events.load(std::memory_order_relaxed);
+            Result.MaxEvents = MaxEvents.load(std::memory_order_relaxed);
+            Result.Blocked = Blocked.load(std::memory_order_relaxed);
+            Result.Handling = Handling.load(std::memory_order_relaxed);
+            Result.Ticks = Ticks.load(std::memory_order_relaxed);
+            Result.Lag = Lag.load(std::memory_order_relaxed);
+            Result.MaxLag = MaxLag.load(std::memory_order_relaxed);
+            Result.Wakeups = Wakeups.load(std::memory_order_relaxed);
+            Result.Actions = Actions.load(std::memory_order_relaxed);
+            Result.MaxActionsPerWakeup = MaxActionsPerWakeup.load(std::memory_order_relaxed);
+            Result.Syscalls = Calls.load(std::memory_order_relaxed);
+
+            for (size_t i = 0; i < Buckets; i++)
+                Result.Callbacks[i] = Callbacks[i].load(std::memory_order_relaxed);
+
+            return Result;
+        }
+
+    private:
+        static inline void Add(std::atomic<uint64_t> &Counter, uint64_t Value)
+        {
+            Counter.store(Counter.load(std::memory_order_relaxed) + Value, std::memory_order_relaxed);
+        }
+
+        static inline void Max(std::atomic<uint64_t> &Counter, uint64_t Value)
+        {
+            if (Value > Counter.load(std::memory_order_relaxed))
+                Counter.store(Value, std::memory_order_relaxed);
+        }
+
+        std::atomic<uint64_t> Waits{0};
+        std::atomic<uint64_t> Events{0};
+        std::atomic<uint64_t> MaxEvents{0};
+        std::atomic<uint64_t> Blocked{0};
+        std::atomic<uint64_t> Handling{0};
+        std::atomic<uint64_t> Ticks{0};
+        std::atomic<uint64_t> Lag{0};
+        std::atomic<uint64_t> MaxLag{0};
+        std::atomic<uint64_t> Wakeups{0};
+        std::atomic<uint64_t> Actions{0};
+        std::atomic<uint64_t> MaxActionsPerWakeup{0};
+        std::atomic<uint64_t> Calls{0};
+        std::atomic<uint64_t> Callbacks[Buckets]{};
+    };
+}
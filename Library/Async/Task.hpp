@@ -0,0 +1,303 @@
+#pragma once
+
+#include <array>
+#include <cerrno>
+#include <coroutine>
+#include <exception>
+#include <system_error>
+#include <unistd.h>
+
+#include <Descriptor.hpp>
+#include <Async/EventLoop.hpp>
+
+namespace Core::Async
+{
+    /**
+     * @brief Size-classed free lists for coroutine frames
+     * Each loop runs on its own thread so the thread local cache
+     * doubles as a per-loop pool and needs no locking.
+     */
+    class FramePool
+    {
+    public:
+        static constexpr size_t Granularity = 64;
+        static constexpr size_t Classes = 32;
+        static constexpr size_t Retain = 256;
+
+        static void *Allocate(size_t Size)
+        {
+            size_t Class = Index(Size);
+
+            if (Class >= Classes)
+                return ::operator new(Size);
+
+            auto &List = Local().Lists[Class];
+
+            if (List.Head)
+            {
+                Block *Item = List.Head;
+
+                List.Head = Item->Next;
+                List.Count--;
+
+                return Item;
+            }
+
+            return ::operator new((Class + 1) * Granularity);
+        }
+
+        static void Release(void *Pointer, size_t Size) noexcept
+        {
+            size_t Class = Index(Size);
+
+            if (Class >= Classes)
+            {
+                ::operator delete(Pointer);
+                return;
+            }
+
+            auto &List = Local().Lists[Class];
+
+            if (List.Count >= Retain)
+            {
+                ::operator delete(Pointer);
+                return;
+            }
+
+            List.Head = new (Pointer) Block{List.Head};
+            List.Count++;
+        }
+
+    private:
+        struct Block
+        {
+            Block *Next;
+        };
+
+        struct FreeList
+        {
+            Block *Head = nullptr;
+            size_t Count = 0;
+        };
+
+        struct Cache
+        {
+            std::array<FreeList, Classes> Lists;
+
+            ~Cache()
+            {
+                for (auto &List : Lists)
+                {
+                    while (List.Head)
+                    {
+                        Block *Next = List.Head->Next;
+                        ::operator delete(List.Head);
+                        List.Head = Next;
+                    }
+                }
+            }
+        };
+
+        static inline size_t Index(size_t Size)
+        {
+            return Size ? (Size - 1) / Granularity : 0;
+        }
+
+        static Cache &Local()
+        {
+            thread_local Cache Instance;
+            return Instance;
+        }
+    };
+
+    /**
+     * @brief Fire and forget coroutine
+     * Starts eagerly on the calling thread and frees its frame when it
+     * returns. Exceptions escaping the body terminate, just like they
+     * would when thrown out of a loop's callback.
+     */
+    class Task
+    {
+    public:
+        struct promise_type
+        {
+            inline Task get_return_object() noexcept { return {}; }
+
+            inline std::suspend_never initial_suspend() noexcept { return {}; }
+
+            inline std::suspend_never final_suspend() noexcept { return {}; }
+
+            inline void return_void() noexcept {}
+
+            inline void unhandled_exception() noexcept { std::terminate(); }
+
+            static void *operator new(size_t Size)
+            {
+                return FramePool::Allocate(Size);
+            }
+
+            static void operator delete(void *Pointer, size_t Size) noexcept
+            {
+                FramePool::Release(Pointer, Size);
+            }
+        };
+    };
+
+    /**
+     * @brief Descriptor registered on a loop for coroutine handlers
+     * Reads and writes are attempted right away and only suspend when
+     * they would block, in which case the descriptor is armed one-shot
+     * and the loop resumes the coroutine directly from its dispatch.
+     * Must be created and destroyed on the loop's thread and allows
+     * one outstanding operation at a time.
+     */
+    class Stream
+    {
+    public:
+        struct Operation
+        {
+            std::coroutine_handle<> Handle = nullptr;
+            ePoll::Event Mask = 0;
+
+            // Retries the operation, false if it would still block
+            bool (*Attempt)(Operation *) = nullptr;
+        };
+
+        template <bool Reading>
+        struct TransferAwaiter : public Operation
+        {
+            Stream &Owner;
+            void *Buffer;
+            size_t Size;
+            ssize_t Result = 0;
+            int Error = 0;
+
+            TransferAwaiter(Stream &owner, void *buffer, size_t size) : Operation{nullptr, Reading ? ePoll::In : ePoll::Out, &TransferAwaiter::Try}, Owner(owner), Buffer(buffer), Size(size) {}
+
+            inline bool await_ready()
+            {
+                return Try(this);
+            }
+
+            inline void await_suspend(std::coroutine_handle<> handle)
+            {
+                Handle = handle;
+                Owner.Wait(this);
+            }
+
+            ssize_t await_resume()
+            {
+                if (Error)
+                    throw std::system_error(Error, std::generic_category());
+
+                return Result;
+            }
+
+        private:
+            static bool Try(Operation *Self)
+            {
+                auto &Item = *static_cast<TransferAwaiter *>(Self);
+                int INode = Item.Owner.File().INode();
+
+                if constexpr (Reading)
+                    Item.Result = ::read(INode, Item.Buffer, Item.Size);
+                else
+                    Item.Result = ::write(INode, Item.Buffer, Item.Size);
+
+                if (Item.Result >= 0)
+                    return true;
+
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                    return false;
+
+                Item.Error = errno;
+                return true;
+            }
+        };
+
+        using ReadAwaiter = TransferAwaiter<true>;
+        using WriteAwaiter = TransferAwaiter<false>;
+
+        Stream(EventLoop &loop, Descriptor &&File) : Loop(loop)
+        {
+            File.Blocking(false);
+
+            Id = Loop.Attach(std::move(File), Resumer{this}, nullptr, {0, 0}, ePoll::OneShot);
+        }
+
+        Stream(Stream const &Other) = delete;
+        Stream(Stream &&Other) = delete;
+
+        ~Stream()
+        {
+            Loop.Remove(Id);
+        }
+
+        Stream &operator=(Stream const &Other) = delete;
+        Stream &operator=(Stream &&Other) = delete;
+
+        // Properties
+
+        inline Descriptor &File()
+        {
+            return Loop.Find(Id)->File;
+        }
+
+        // Functionalities
+
+        /**
+         * @brief Usage : ssize_t Count = co_await Client.Read(Buffer, Size);
+         * @return Bytes read, 0 on end of stream
+         */
+        inline ReadAwaiter Read(void *Buffer, size_t Size)
+        {
+            return {*this, Buffer, Size};
+        }
+
+        /**
+         * @brief Usage : ssize_t Count = co_await Client.Write(Buffer, Size);
+         * @return Bytes written, may be less than Size
+         */
+        inline WriteAwaiter Write(void const *Buffer, size_t Size)
+        {
+            return {*this, const_cast<void *>(Buffer), Size};
+        }
+
+    private:
+        struct Resumer
+        {
+            Stream *Owner;
+
+            void operator()(EventLoop::Context &Context, ePoll::Entry &)
+            {
+                Operation *Pending = Owner->Pending;
+
+                if (!Pending)
+                    return;
+
+                if (!Pending->Attempt(Pending))
+                {
+                    Context.Loop.Modify(Context.Self, Pending->Mask | ePoll::OneShot);
+                    return;
+                }
+
+                Owner->Pending = nullptr;
+
+                // Resuming may destroy the stream and this entry, nothing may follow
+
+                Pending->Handle.resume();
+            }
+        };
+
+        EventLoop &Loop;
+        EventLoop::Handle Id;
+        Operation *Pending = nullptr;
+
+        void Wait(Operation *Item)
+        {
+            Pending = Item;
+
+            Loop.Modify(*Loop.Find(Id), Item->Mask | ePoll::OneShot);
+        }
+    };
+}
@@ -4,7 +4,10 @@
 #include <mutex>
 #include <future>
 #include <atomic>
-#include <mutex>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
 
 #include <Event.hpp>
 #include <Duration.hpp>
@@ -16,19 +19,49 @@
 #include <Network/HTTP/Request.hpp>
 #include <Network/HTTP/Parser.hpp>
 #include <Async/EventLoop.hpp>
+#include <Async/Executor.hpp>
+#include <Async/Watchdog.hpp>
 
 namespace Core::Async
 {
     class ThreadPool
     {
     public:
+        /**
+         * @brief How Next picks a loop for a new connection
+         * RoundRobin : Each loop in turn
+         * LeastConnections : Loop with the fewest live descriptors
+         * PowerOfTwo : Less loaded of two random loops
+         * LeastLag : Loop whose ready events wait the least between wakeup and dispatch
+         */
+        enum class Policies
+        {
+            RoundRobin,
+            LeastConnections,
+            PowerOfTwo,
+            LeastLag,
+        };
+
+        /**
+         * @brief Where a loop's runner ended up, filled in as it starts
+         */
+        struct Binding
+        {
+            cpu_set_t CPUs{};    // CPUs the runner may run on
+            cpu_set_t Request{}; // Explicit CPU set, empty if not given
+            int CPU = -1;        // CPU the runner started on
+            int Node = -1;       // NUMA node of that CPU
+            bool Pinned = false;
+            bool LocalMemory = false;
+        };
+
         ThreadPool() = default;
-        ThreadPool(Duration const &interval, size_t Count) : Loops(Count + 1), Interval(interval)
+        ThreadPool(Duration const &interval, size_t Count, EventLoop::Backends Backend = EventLoop::DefaultBackend) : Loops(Count + 1), Interval(interval), _Bindings(Count + 1)
         {
             Loops.ForEach(
-                [this](EventLoop &Item)
+                [this, Backend](EventLoop &Item)
                 {
-                    Item = Async::EventLoop(Interval);
+                    Item = Async::EventLoop(Interval, Backend);
                 });
 
             Loops.Last().RunnerId = std::this_thread::get_id();
@@ -49,6 +82,13 @@ namespace Core::Async
                     {
                         auto &Loop = Loops[i];
 
+                        Bind(i);
+
+                        Loop.Relocate();
+
+                        Bound.fetch_add(1, std::memory_order_release);
+                        Bound.notify_all();
+
                         AwaitGo();
 
                         Loop.Loop(std::forward<TCallback>(Condition));
@@ -57,7 +97,15 @@ namespace Core::Async
                 Loop.RunnerId = Loop.Runner.get_id();
             }
 
+            // Bindings and relocations are complete for the spawned loops once Run returns
+
+            for (size_t Count; (Count = Bound.load(std::memory_order_acquire)) < Loops.Length() - 1;)
+                Bound.wait(Count);
+
             SignalGo();
+
+            if (Guard)
+                Guard->Start();
         }
 
         template <typename TCallback>
@@ -65,6 +113,10 @@ namespace Core::Async
         {
             HasJoined.store(true);
 
+            Bind(Loops.Length() - 1);
+
+            Loops.Last().Relocate();
+
             AwaitGo();
 
             Loops.Last().Loop(std::forward<TCallback>(Condition));
@@ -74,6 +126,9 @@ namespace Core::Async
 
         void Stop()
         {
+            if (Guard)
+                Guard->Stop();
+
             for (size_t i = 0; i < Loops.Length() - 1; ++i)
             {
                 Loops[i].Notify();
@@ -93,6 +148,187 @@ namespace Core::Async
             return Loops[Index];
         }
 
+        inline void Dispatch(Policies Value)
+        {
+            Policy = Value;
+        }
+
+        inline Policies Dispatch() const
+        {
+            return Policy;
+        }
+
+        /**
+         * @brief Picks the loop for a new connection using the dispatch policy,
+         * safe to call from any thread
+         */
+        EventLoop &Next()
+        {
+            size_t Count = Length();
+
+            if (Count <= 1)
+                return Loops[0];
+
+            switch (Policy)
+            {
+            case Policies::LeastConnections:
+                return Loops[Least(Count, [](EventLoop &Item)
+                                   { return Item.Connections(); })];
+
+            case Policies::LeastLag:
+                return Loops[Least(Count, [](EventLoop &Item)
+                                   { return Item.Lag(); })];
+
+            case Policies::PowerOfTwo:
+            {
+                size_t First = Random() % Count;
+                size_t Second = (First + 1 + Random() % (Count - 1)) % Count;
+
+                return Loops[First].Connections() <= Loops[Second].Connections() ? Loops[First] : Loops[Second];
+            }
+
+            default:
+                return Loops[Turn.fetch_add(1, std::memory_order_relaxed) % Count];
+            }
+        }
+
+        /**
+         * @brief Switches every loop to tickless timers, call before Run
+         */
+        inline void Tickless(bool Value)
+        {
+            Loops.ForEach(
+                [Value](EventLoop &Item)
+                {
+                    Item.Tickless(Value);
+                });
+        }
+
+        /**
+         * @brief Makes the first Count loops spin before sleeping, the rest
+         * keep blocking right away. Call before Run
+         */
+        inline void Spin(Duration const &Budget, bool BusyPoll = false, size_t Count = static_cast<size_t>(-1))
+        {
+            for (size_t i = 0; i < Loops.Length() && i < Count; i++)
+            {
+                Loops[i].Spin(Budget, BusyPoll);
+            }
+        }
+
+        /**
+         * @brief Caps the events every loop takes per wait
+         */
+        inline void MaxEvents(size_t Count)
+        {
+            Loops.ForEach(
+                [Count](EventLoop &Item)
+                {
+                    Item.MaxEvents(Count);
+                });
+        }
+
+        /**
+         * @brief Pins each loop's runner to one CPU, loop i taking the i-th CPU
+         * the process may run on. Call before Run
+         */
+        inline void Pin(bool Value = true)
+        {
+            AutoPin = Value;
+        }
+
+        /**
+         * @brief Pins one loop's runner to the given CPUs, overriding Pin(true)
+         */
+        inline void Pin(size_t Index, cpu_set_t const &CPUs)
+        {
+            _Bindings[Index].Request = CPUs;
+        }
+
+        /**
+         * @brief Makes each runner allocate from its own NUMA node regardless of
+         * the process policy, so storage a loop grows on its thread (handler slab,
+         * wheel entries, connection buffers) stays local. Call before Run
+         */
+        inline void LocalMemory(bool Value = true)
+        {
+            _LocalMemory = Value;
+        }
+
+        /**
+         * @brief CPU the loop's runner will be pinned to by Run, -1 unless
+         * the pin options leave it exactly one CPU
+         */
+        int PinnedCPU(size_t Index)
+        {
+            cpu_set_t Set = Placement(Index);
+
+            if (CPU_COUNT(&Set) != 1)
+                return -1;
+
+            int CPU = 0;
+
+            while (!CPU_ISSET(CPU, &Set))
+                CPU++;
+
+            return CPU;
+        }
+
+        /**
+         * @brief Placement of every started loop, complete for the spawned loops once Run returns
+         */
+        inline Iterable::Span<Binding> const &Bindings() const
+        {
+            return _Bindings;
+        }
+
+        /**
+         * @brief Gives the loops a dedicated executor of Count workers for
+         * offloaded work instead of the shared one. Call before Run
+         */
+        inline void Compute(size_t Count)
+        {
+            Workers = std::make_unique<Executor>(Count);
+
+            Loops.ForEach(
+                [this](EventLoop &Item)
+                {
+                    Item.Compute(*Workers);
+                });
+        }
+
+        /**
+         * @brief Metrics of every loop summed up, per-loop ones come from each
+         * loop's Metrics(). Empty unless built with COREKIT_METRICS
+         */
+        inline LoopMetrics::Snapshot Metrics()
+        {
+            LoopMetrics::Snapshot Result;
+
+            for (size_t i = 0; i < Loops.Length(); i++)
+            {
+                Result += Loops[i].Metrics();
+            }
+
+            return Result;
+        }
+
+        /**
+         * @brief Starts a watchdog with Run that reports callbacks running longer
+         * than Budget on any loop, from its own thread. A non-zero Signal, e.g.
+         * SIGRTMIN, also captures the stalled runner's stack by interrupting it
+         * with that signal, which must not be used for anything else. Call before Run
+         */
+        template <typename TCallback>
+        inline void Watch(Duration const &Budget, TCallback &&OnStall, int Signal = 0)
+        {
+#ifdef COREKIT_NO_HEARTBEAT
+            static_assert(!sizeof(TCallback), "Watchdogs need the loop heartbeats that COREKIT_NO_HEARTBEAT turns off");
+#endif
+
+            Guard = std::make_unique<Watchdog>(Loops, Budget, Watchdog::CallbackType(std::forward<TCallback>(OnStall)), Signal);
+        }
+
         template <typename TCallback>
         inline void InitStorages(TCallback &&Callback)
         {
@@ -107,6 +343,17 @@ namespace Core::Async
         Duration Interval;
         std::atomic_bool HasJoined{false};
 
+        Policies Policy = Policies::RoundRobin;
+        std::atomic<size_t> Turn{0};
+
+        std::unique_ptr<Executor> Workers;
+        std::unique_ptr<Watchdog> Guard;
+
+        bool AutoPin = false;
+        bool _LocalMemory = false;
+        Iterable::Span<Binding> _Bindings;
+        std::atomic<size_t> Bound{0};
+
         std::promise<void> GoPromise;
         std::shared_future<void> GoFuture{GoPromise.get_future()};
 
@@ -119,5 +366,96 @@ namespace Core::Async
         {
             GoFuture.get();
         }
+
+        /**
+         * @brief CPUs the loop's runner gets pinned to, empty if it isn't pinned
+         */
+        cpu_set_t Placement(size_t Index)
+        {
+            cpu_set_t Set = _Bindings[Index].Request;
+
+            if (!CPU_COUNT(&Set) && AutoPin)
+            {
+                cpu_set_t Allowed;
+
+                if (sched_getaffinity(0, sizeof(Allowed), &Allowed) == 0 && CPU_COUNT(&Allowed))
+                {
+                    size_t Skip = Index % CPU_COUNT(&Allowed);
+
+                    for (int CPU = 0; CPU < CPU_SETSIZE; CPU++)
+                    {
+                        if (CPU_ISSET(CPU, &Allowed) && !Skip--)
+                        {
+                            CPU_SET(CPU, &Set);
+                            break;
+                        }
+                    }
+                }
+            }
+
+            return Set;
+        }
+
+        /**
+         * @brief Applies the placement options on the calling runner and records the outcome
+         * Failures are recorded rather than thrown since they happen on the runner's thread
+         */
+        void Bind(size_t Index)
+        {
+            auto &Item = _Bindings[Index];
+            cpu_set_t Set = Placement(Index);
+
+            if (CPU_COUNT(&Set))
+                Item.Pinned = sched_setaffinity(0, sizeof(Set), &Set) == 0;
+
+            if (_LocalMemory)
+                Item.LocalMemory = syscall(SYS_set_mempolicy, MPOL_LOCAL, nullptr, 0) == 0;
+
+            sched_getaffinity(0, sizeof(Item.CPUs), &Item.CPUs);
+
+            unsigned CPU = 0;
+            unsigned Node = 0;
+
+            if (syscall(SYS_getcpu, &CPU, &Node, nullptr) == 0)
+            {
+                Item.CPU = static_cast<int>(CPU);
+                Item.Node = static_cast<int>(Node);
+            }
+        }
+
+        template <typename TCallback>
+        size_t Least(size_t Count, TCallback &&Measure)
+        {
+            // Start from a rotating offset so ties don't all land on the first loop
+
+            size_t Start = Turn.fetch_add(1, std::memory_order_relaxed) % Count;
+            size_t Result = Start;
+            auto Minimum = Measure(Loops[Start]);
+
+            for (size_t i = 1; i < Count; i++)
+            {
+                size_t Index = (Start + i) % Count;
+                auto Value = Measure(Loops[Index]);
+
+                if (Value < Minimum)
+                {
+                    Minimum = Value;
+                    Result = Index;
+                }
+            }
+
+            return Result;
+        }
+
+        static inline uint32_t Random()
+        {
+            thread_local uint32_t State = 2463534242u ^ static_cast<uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+            State ^= State << 13;
+            State ^= State >> 17;
+            State ^= State << 5;
+
+            return State;
+        }
     };
 }
\ No newline at end of file
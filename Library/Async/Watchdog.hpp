@@ -0,0 +1,291 @@
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <string>
+#include <chrono>
+#include <cerrno>
+#include <cstdint>
+#include <csignal>
+#include <cstdlib>
+#include <algorithm>
+#include <condition_variable>
+#include <pthread.h>
+#include <execinfo.h>
+
+#include <Duration.hpp>
+#include <Function.hpp>
+#include <Iterable/Span.hpp>
+#include <Iterable/List.hpp>
+#include <Async/EventLoop.hpp>
+
+namespace Core::Async
+{
+    /**
+     * @brief Thread watching the heartbeat of a set of loops for callbacks
+     * that keep a loop busy past a budget. A stall is reported once when it
+     * crosses the budget, with the runner's stack if a capture signal is set,
+     * and once more after the loop moved on. Loops are scanned every quarter
+     * of the budget so durations are accurate to about that much. Loops built
+     * with COREKIT_NO_HEARTBEAT publish no heartbeat and never stall.
+     */
+    class Watchdog
+    {
+    public:
+        struct Stall
+        {
+            size_t Loop = 0;            // Index of the loop
+            EventLoop::Handle Entry;    // Entry whose callback was running
+            char const *Type = nullptr; // Mangled type of that callback, null for the loop's own work
+            Duration Elapsed;           // How long it has been running
+            bool Ongoing = true;        // Cleared on the report made once the callback returned
+            Iterable::List<std::string> Stack = Iterable::List<std::string>(1);
+        };
+
+        using CallbackType = Core::Function<void(Stall const &)>;
+
+        Watchdog(Iterable::Span<EventLoop> &loops, Duration const &budget, CallbackType &&callback, int signal = 0)
+            : Loops(loops),
+              Tracks(loops.Length()),
+              Budget(std::max<size_t>(budget.AsMicroseconds(), 1)),
+              Callback(std::move(callback)),
+              Signal(signal)
+        {
+        }
+
+        Watchdog(Watchdog const &Other) = delete;
+
+        ~Watchdog()
+        {
+            Stop();
+        }
+
+        Watchdog &operator=(Watchdog const &Other) = delete;
+
+        void Start()
+        {
+            if (Runner.joinable())
+                return;
+
+            if (Signal)
+            {
+                // Loads the unwinder up front since the first backtrace allocates
+
+                void *Warm[1];
+                backtrace(Warm, 1);
+
+                struct sigaction Action{};
+
+                Action.sa_sigaction = &Watchdog::OnSignal;
+                Action.sa_flags = SA_RESTART | SA_SIGINFO;
+                sigemptyset(&Action.sa_mask);
+
+                sigaction(Signal, &Action, nullptr);
+            }
+
+            Stopping = false;
+
+            Runner = std::thread(
+                [this]
+                {
+                    auto Period = std::chrono::microseconds(std::max<size_t>(Budget / 4, 1000));
+                    std::unique_lock Lock(Mutex);
+
+                    while (!Wake.wait_for(Lock, Period, [this] { return Stopping; }))
+                    {
+                        Lock.unlock();
+                        Scan();
+                        Lock.lock();
+                    }
+                });
+        }
+
+        void Stop()
+        {
+            if (!Runner.joinable())
+                return;
+
+            {
+                std::lock_guard Lock(Mutex);
+                Stopping = true;
+            }
+
+            Wake.notify_one();
+            Runner.join();
+        }
+
+    private:
+        struct Track
+        {
+            uint64_t Count = 0;
+            size_t Since = 0;
+            bool Reported = false;
+            Stall Record;
+        };
+
+        static constexpr int MaxFrames = 64;
+
+        Iterable::Span<EventLoop> &Loops;
+        Iterable::Span<Track> Tracks;
+        size_t Budget;
+        CallbackType Callback;
+        int Signal;
+
+        std::thread Runner;
+        std::mutex Mutex;
+        std::condition_variable Wake;
+        bool Stopping = false;
+
+        // A single capture runs at a time across every watchdog in the process.
+        // Each capture's signal carries its sequence number and the handler
+        // must claim that number from Open before writing Frames, so a signal
+        // arriving after its capture gave up can't write into a later one
+
+        static inline std::mutex CaptureLock;
+        static inline uint64_t Sequence = 0;
+        static inline void *Frames[MaxFrames];
+        static inline std::atomic<uint64_t> Open{0};
+        static inline std::atomic<uint64_t> Finished{0};
+        static inline std::atomic<int> Captured{0};
+
+        static inline size_t Monotonic()
+        {
+            timespec Now;
+
+            clock_gettime(CLOCK_MONOTONIC, &Now);
+
+            return Now.tv_sec * 1000000 + Now.tv_nsec / 1000;
+        }
+
+        /**
+         * @brief Unwinds the interrupted thread's stack into Frames
+         * backtrace() is not async-signal-safe. Start warms it up so it doesn't
+         * allocate or load the unwinder here, but a signal landing while the thread
+         * holds a lock the unwinder needs can still deadlock it, which is why
+         * capturing stacks is opt-in through the signal argument
+         */
+        static void OnSignal(int, siginfo_t *Info, void *)
+        {
+            int Saved = errno;
+            uint64_t Current = reinterpret_cast<uintptr_t>(Info->si_value.sival_ptr);
+
+            // Only the handler of the capture still open writes Frames
+
+            if (Current && Open.compare_exchange_strong(Current, 0, std::memory_order_acq_rel))
+            {
+                Captured.store(backtrace(Frames, MaxFrames), std::memory_order_relaxed);
+                Finished.store(Current, std::memory_order_release);
+            }
+
+            errno = Saved;
+        }
+
+        void Scan()
+        {
+            size_t Now = Monotonic();
+
+            for (size_t i = 0; i < Tracks.Length(); i++)
+            {
+                auto Pulse = Loops[i].Heartbeat();
+                auto &Item = Tracks[i];
+
+                if (Pulse.Count != Item.Count || Pulse.Waiting)
+                {
+                    if (Item.Reported)
+                    {
+                        Item.Record.Elapsed = Duration::FromMicroseconds(Now - Item.Since);
+                        Item.Record.Ongoing = false;
+
+                        Callback(Item.Record);
+                    }
+
+                    Item.Count = Pulse.Count;
+                    Item.Since = Now;
+                    Item.Reported = false;
+
+                    continue;
+                }
+
+                if (Item.Reported || Now - Item.Since < Budget)
+                    continue;
+
+                // The entry is only looked at now, it stays put while its callback
+                // runs and a loop that moved on in the meantime isn't stalled
+
+                Item.Record.Entry = Pulse.Self ? Pulse.Self->Id : EventLoop::Handle{};
+                Item.Record.Type = Pulse.Self ? Pulse.Self->Callback.TypeName() : nullptr;
+
+                if (Loops[i].Heartbeat().Count != Pulse.Count)
+                    continue;
+
+                Item.Reported = true;
+                Item.Record.Loop = i;
+                Item.Record.Elapsed = Duration::FromMicroseconds(Now - Item.Since);
+                Item.Record.Ongoing = true;
+                Item.Record.Stack.Free();
+
+                if (Signal)
+                    Capture(Loops[i], Item.Record.Stack);
+
+                Callback(Item.Record);
+            }
+        }
+
+        /**
+         * @brief Has the loop's thread unwind its own stack from the signal handler
+         * Gives up after about 50ms unless the handler started, e.g. when the thread blocks the signal
+         */
+        void Capture(EventLoop &Loop, Iterable::List<std::string> &Stack)
+        {
+            std::lock_guard Lock(CaptureLock);
+
+            uint64_t Current = ++Sequence;
+
+            Open.store(Current, std::memory_order_release);
+
+            sigval Value{};
+            Value.sival_ptr = reinterpret_cast<void *>(static_cast<uintptr_t>(Current));
+
+            if (pthread_sigqueue(Loop.NativeThread(), Signal, Value) != 0)
+            {
+                Open.store(0, std::memory_order_relaxed);
+                return;
+            }
+
+            for (size_t i = 0; i < 1000 && Finished.load(std::memory_order_acquire) != Current; i++)
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+
+            if (Finished.load(std::memory_order_acquire) != Current)
+            {
+                // Closing the capture fails only if the handler already claimed
+                // it, it then has to finish before Frames can be reused
+
+                uint64_t Expected = Current;
+
+                if (Open.compare_exchange_strong(Expected, 0, std::memory_order_acq_rel))
+                    return;
+
+                while (Finished.load(std::memory_order_acquire) != Current)
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+
+            int Count = Captured.load(std::memory_order_relaxed);
+
+            if (Count <= 0)
+                return;
+
+            char **Symbols = backtrace_symbols(Frames, Count);
+
+            if (!Symbols)
+                return;
+
+            // Skips the handler's own frame
+
+            for (int i = 1; i < Count; i++)
+                Stack.Add(Symbols[i]);
+
+            free(Symbols);
+        }
+    };
+}
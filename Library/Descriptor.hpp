@@ -79,7 +79,12 @@ namespace Core
 
             if (Result < 0)
             {
-                throw std::system_error(errno, std::generic_category());
+                auto EB = errno;
+
+                if (EB == EAGAIN)
+                    return 0;
+
+                throw std::system_error(EB, std::generic_category());
             }
 
             return Result;
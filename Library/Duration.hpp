@@ -54,7 +54,7 @@ namespace Core
 
         static constexpr Duration FromMicroseconds(size_t microseconds)
         {
-            return Duration(microseconds / 1000'000, (microseconds % 1000) * 1e3);
+            return Duration(microseconds / 1000'000, (microseconds % 1000'000) * 1e3);
         }
 
         void AddMilliseconds(time_t Value)
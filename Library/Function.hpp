@@ -1,5 +1,9 @@
 #pragma once
 
+#include <new>
+#include <cstddef>
+#include <cstring>
+#include <typeinfo>
 #include <type_traits>
 #include <stdexcept>
 #include <utility>
@@ -15,16 +19,19 @@ namespace Core
     public:
         using TObject = void *;
         using TInvoker = TRet (*)(void *, TArgs &&...);
-        using TDestructor = void (*)(void const *);
-        using TCopyConstructor = void (*)(void **, void const *);
+        using TDestructor = void (*)(void *);
+        using TCopyConstructor = void (*)(void *, void const *);
 
         constexpr static size_t SmallSize = sizeof(TObject);
 
         constexpr Function() = default;
 
-        constexpr Function(Function &&Other) noexcept : Object(Other.Object), Invoker(Other.Invoker), Destructor(Other.Destructor), CopyConstructor(Other.CopyConstructor), Hash(Other.Hash)
+        constexpr Function(Function &&Other) noexcept : Invoker(Other.Invoker), Destructor(Other.Destructor), CopyConstructor(Other.CopyConstructor), Hash(Other.Hash)
         {
-            Other.Object = nullptr;
+            // Small callables are relocated bitwise along with the storage
+
+            std::memcpy(Storage, Other.Storage, SmallSize);
+
             Other.Invoker = nullptr;
             Other.Destructor = nullptr;
             Other.CopyConstructor = nullptr;
@@ -35,7 +42,7 @@ namespace Core
         {
             Other.AssertCopyable();
 
-            CopyConstructor(&Object, Other.Object);
+            CopyConstructor(Storage, Other.Storage);
         }
 
         constexpr Function(std::nullptr_t) noexcept {};
@@ -45,30 +52,27 @@ namespace Core
         {
             if constexpr (sizeof(T) > SmallSize)
             {
-                Object = new T(std::forward<TCArgs>(CArgs)...);
+                // Storage holds a pointer to the callable
+
+                ::new (static_cast<void *>(Storage)) T *(new T(std::forward<TCArgs>(CArgs)...));
 
                 Invoker = [](void *Item, TArgs &&...Args)
                 {
-                    return static_cast<T *>(Item)->operator()(std::forward<TArgs>(Args)...);
+                    return (*std::launder(static_cast<T **>(Item)))->operator()(std::forward<TArgs>(Args)...);
                 };
 
-                if constexpr (!std::is_trivially_destructible_v<T>)
-                {
-                    Destructor = [](void const *Item)
-                    {
-                        delete static_cast<T const *>(Item);
-                    };
-                }
-                else
+                // Freed even when trivially destructible
+
+                Destructor = [](void *Item)
                 {
-                    Destructor = nullptr;
-                }
+                    delete *std::launder(static_cast<T **>(Item));
+                };
 
                 if constexpr (std::is_copy_constructible_v<T> || std::is_trivially_constructible_v<T>)
                 {
-                    CopyConstructor = [](void **Self, void const *Other)
+                    CopyConstructor = [](void *Self, void const *Other)
                     {
-                        *Self = new T(*static_cast<T const *>(Other));
+                        ::new (Self) T *(new T(**std::launder(static_cast<T *const *>(Other))));
                     };
                 }
                 else
@@ -78,18 +82,20 @@ namespace Core
             }
             else
             {
-                std::construct_at(static_cast<T *>(static_cast<void *>(&Object)), std::forward<TCArgs>(CArgs)...);
+                // Storage holds the callable itself
+
+                ::new (static_cast<void *>(Storage)) T(std::forward<TCArgs>(CArgs)...);
 
                 Invoker = [](void *Item, TArgs &&...Args)
                 {
-                    return static_cast<T *>(static_cast<void *>(&Item))->operator()(std::forward<TArgs>(Args)...);
+                    return std::launder(static_cast<T *>(Item))->operator()(std::forward<TArgs>(Args)...);
                 };
 
                 if constexpr (!std::is_trivially_destructible_v<T>)
                 {
-                    Destructor = [](void const *Item)
+                    Destructor = [](void *Item)
                     {
-                        static_cast<T const *>(static_cast<void *>(&Item))->~T();
+                        std::launder(static_cast<T *>(Item))->~T();
                     };
                 }
                 else
@@ -99,9 +105,9 @@ namespace Core
 
                 if constexpr (std::is_copy_constructible_v<T> || std::is_trivially_constructible_v<T>)
                 {
-                    CopyConstructor = [](void **Self, void const *Other)
+                    CopyConstructor = [](void *Self, void const *Other)
                     {
-                        std::construct_at(static_cast<T *>(static_cast<void *>(Self)), *static_cast<T const *>(static_cast<void *>(&Other)));
+                        ::new (Self) T(*std::launder(static_cast<T const *>(Other)));
                     };
                 }
                 else
@@ -113,24 +119,25 @@ namespace Core
 
         template <typename TFunctor>
         constexpr Function(TFunctor &&Functor) noexcept
-            : Function(std::type_identity<TFunctor>{}, std::forward<TFunctor>(Functor)) {}
+        requires(!std::is_same_v<std::decay_t<TFunctor>, Function>)
+            : Function(std::type_identity<std::decay_t<TFunctor>>{}, std::forward<TFunctor>(Functor)) {}
 
         constexpr Function(TRet (*Function)(TArgs...)) noexcept
-            : Object(reinterpret_cast<void *>(Function)),
-              Invoker(
+            : Invoker(
                   [](void *Item, TArgs &&...Args)
                   {
-                      return (reinterpret_cast<TRet (*)(TArgs...)>(Item))(std::forward<TArgs>(Args)...);
+                      return (*std::launder(static_cast<TRet (**)(TArgs...)>(Item)))(std::forward<TArgs>(Args)...);
                   }),
               Destructor(nullptr),
               CopyConstructor(
-                  [](void **Self, void const *Other)
+                  [](void *Self, void const *Other)
                   {
-                      // @todo Fix this!!
-
-                      *Self = (void *)Other;
+                      ::new (Self) (TRet (*)(TArgs...))(*std::launder(static_cast<TRet (*const *)(TArgs...)>(Other)));
                   }),
-              Hash(typeid(decltype(Function)).name()) {}
+              Hash(typeid(decltype(Function)).name())
+        {
+            ::new (static_cast<void *>(Storage)) (TRet (*)(TArgs...))(Function);
+        }
 
         template <typename TFunctor>
         constexpr Function &operator=(TFunctor &&Functor)
@@ -138,7 +145,7 @@ namespace Core
         {
             // @todo Optimize this
 
-            *this = Function(std::type_identity<TFunctor>{}, std::forward<TFunctor>(Functor));
+            *this = Function(std::type_identity<std::decay_t<TFunctor>>{}, std::forward<TFunctor>(Functor));
 
             return *this;
         }
@@ -149,13 +156,13 @@ namespace Core
             {
                 Clear();
 
-                Object = Other.Object;
+                std::memcpy(Storage, Other.Storage, SmallSize);
+
                 Invoker = Other.Invoker;
                 CopyConstructor = Other.CopyConstructor;
                 Destructor = Other.Destructor;
                 Hash = Other.Hash;
 
-                Other.Object = nullptr;
                 Other.Invoker = nullptr;
                 Other.CopyConstructor = nullptr;
                 Other.Destructor = nullptr;
@@ -176,7 +183,7 @@ namespace Core
             Destructor = Other.Destructor;
             Hash = Other.Hash;
 
-            CopyConstructor(&Object, Other.Object);
+            CopyConstructor(Storage, Other.Storage);
             return *this;
         }
 
@@ -194,7 +201,7 @@ namespace Core
         {
             if (Destructor)
             {
-                Destructor(Object);
+                Destructor(Storage);
                 Destructor = nullptr;
             }
 
@@ -207,12 +214,15 @@ namespace Core
             if (typeid(T).name() != Hash)
                 throw std::bad_cast();
 
-            return static_cast<T *>(Object);
+            if constexpr (sizeof(T) > SmallSize)
+                return *std::launder(reinterpret_cast<T **>(Storage));
+            else
+                return std::launder(reinterpret_cast<T *>(Storage));
         }
 
         constexpr inline TRet operator()(TArgs... Args) const
         {
-            return Invoker(Object, std::forward<TArgs>(Args)...);
+            return Invoker(Storage, std::forward<TArgs>(Args)...);
         }
 
         constexpr inline operator bool() const
@@ -220,8 +230,16 @@ namespace Core
             return bool(Invoker);
         }
 
+        /**
+         * @brief Mangled name of the stored callable's type, null if empty
+         */
+        constexpr inline char const *TypeName() const
+        {
+            return Hash;
+        }
+
     protected:
-        TObject Object = nullptr;
+        alignas(TObject) mutable std::byte Storage[SmallSize] = {};
         TInvoker Invoker = nullptr;
         TDestructor Destructor = nullptr;
         TCopyConstructor CopyConstructor = nullptr;
@@ -0,0 +1,254 @@
+#pragma once
+
+#include <memory>
+#include <cstdint>
+#include <stdexcept>
+
+#include <Iterable/List.hpp>
+
+namespace Core::Iterable
+{
+    struct SlabHandle
+    {
+        uint32_t Index = 0;
+        uint32_t Generation = 0;
+
+        constexpr inline uint64_t Pack() const
+        {
+            return (static_cast<uint64_t>(Generation) << 32) | Index;
+        }
+
+        static constexpr inline SlabHandle Unpack(uint64_t Value)
+        {
+            return {static_cast<uint32_t>(Value), static_cast<uint32_t>(Value >> 32)};
+        }
+
+        constexpr bool operator==(SlabHandle const &Other) const = default;
+    };
+
+    /**
+     * @brief Chunked object pool with stable addresses
+     * Objects are addressed by slot index plus a generation counter
+     * which is bumped on every removal, so a handle to a recycled
+     * slot is detected instead of reaching the new occupant.
+     */
+    template <typename T, size_t ChunkSize = 256>
+    class Slab final
+    {
+    public:
+        using Handle = SlabHandle;
+
+        // Constructors
+
+        Slab() = default;
+        Slab(Slab const &Other) = delete;
+        Slab(Slab &&Other) noexcept : Chunks(std::move(Other.Chunks)), FreeSlot(Other.FreeSlot), _Length(Other._Length), _Capacity(Other._Capacity)
+        {
+            Other.FreeSlot = None;
+            Other._Length = 0;
+            Other._Capacity = 0;
+        }
+
+        ~Slab()
+        {
+            Free();
+        }
+
+        // Operators
+
+        Slab &operator=(Slab const &Other) = delete;
+        Slab &operator=(Slab &&Other) noexcept
+        {
+            if (this != &Other)
+            {
+                Free();
+
+                Chunks = std::move(Other.Chunks);
+                FreeSlot = Other.FreeSlot;
+                _Length = Other._Length;
+                _Capacity = Other._Capacity;
+
+                Other.FreeSlot = None;
+                Other._Length = 0;
+                Other._Capacity = 0;
+            }
+
+            return *this;
+        }
+
+        T &operator[](Handle Id)
+        {
+            T *Item = Find(Id);
+
+            if (!Item)
+                throw std::out_of_range("Stale slab handle");
+
+            return *Item;
+        }
+
+        // Peroperties
+
+        inline size_t Length() const { return _Length; }
+
+        inline size_t Capacity() const { return _Capacity; }
+
+        inline bool IsEmpty() const { return _Length == 0; }
+
+        // Functionalities
+
+        template <typename... TArgs>
+        Handle Add(TArgs &&...Args)
+        {
+            if (FreeSlot == None)
+                Grow();
+
+            uint32_t Index = FreeSlot;
+            Slot &Item = At(Index);
+
+            // Take the slot before constructing in case the constructor re-enters
+
+            FreeSlot = Item.Next;
+
+            try
+            {
+                std::construct_at(Item.Pointer(), std::forward<TArgs>(Args)...);
+            }
+            catch (...)
+            {
+                Item.Next = FreeSlot;
+                FreeSlot = Index;
+                throw;
+            }
+
+            Item.Used = true;
+            _Length++;
+
+            return {Index, Item.Generation};
+        }
+
+        inline T *Find(Handle Id)
+        {
+            if (Id.Index >= _Capacity)
+                return nullptr;
+
+            Slot &Item = At(Id.Index);
+
+            return Item.Used && Item.Generation == Id.Generation ? Item.Pointer() : nullptr;
+        }
+
+        void Remove(Handle Id)
+        {
+            if (!Find(Id))
+                return;
+
+            Slot &Item = At(Id.Index);
+
+            // Invalidate the handle first so the destructor can't reach it again
+
+            Item.Used = false;
+            Item.Generation = Item.Generation + 1 ? Item.Generation + 1 : 1;
+
+            std::destroy_at(Item.Pointer());
+
+            Item.Next = FreeSlot;
+            FreeSlot = Id.Index;
+            _Length--;
+        }
+
+        template <typename TCallback>
+        void ForEach(TCallback Action)
+        {
+            for (uint32_t i = 0; i < _Capacity; i++)
+            {
+                Slot &Item = At(i);
+
+                if (Item.Used)
+                    Action(*Item.Pointer());
+            }
+        }
+
+        /**
+         * @brief Moves every object into chunks allocated by the calling thread,
+         * so they land on its NUMA node. Handles stay valid but pointers don't
+         */
+        void Relocate()
+        {
+            for (size_t c = 0; c < Chunks.Length(); c++)
+            {
+                auto Chunk = std::make_unique<Slot[]>(ChunkSize);
+
+                for (size_t i = 0; i < ChunkSize; i++)
+                {
+                    Slot &Old = Chunks[c][i];
+                    Slot &Item = Chunk[i];
+
+                    Item.Generation = Old.Generation;
+                    Item.Next = Old.Next;
+                    Item.Used = Old.Used;
+
+                    if (!Old.Used)
+                        continue;
+
+                    std::construct_at(Item.Pointer(), std::move(*Old.Pointer()));
+                    std::destroy_at(Old.Pointer());
+                }
+
+                Chunks[c] = std::move(Chunk);
+            }
+        }
+
+        void Free()
+        {
+            for (uint32_t i = 0; i < _Capacity; i++)
+            {
+                Slot &Item = At(i);
+
+                if (Item.Used)
+                    Remove({i, Item.Generation});
+            }
+        }
+
+    private:
+        static constexpr uint32_t None = static_cast<uint32_t>(-1);
+
+        struct Slot
+        {
+            alignas(T) unsigned char Storage[sizeof(T)];
+            uint32_t Generation = 1;
+            uint32_t Next = None;
+            bool Used = false;
+
+            inline T *Pointer()
+            {
+                return std::launder(reinterpret_cast<T *>(Storage));
+            }
+        };
+
+        List<std::unique_ptr<Slot[]>> Chunks;
+        uint32_t FreeSlot = None;
+        size_t _Length = 0;
+        uint32_t _Capacity = 0;
+
+        inline Slot &At(uint32_t Index)
+        {
+            return Chunks[Index / ChunkSize][Index % ChunkSize];
+        }
+
+        void Grow()
+        {
+            Chunks.Add(std::make_unique<Slot[]>(ChunkSize));
+
+            // Chain the new slots in order so they're handed out sequentially
+
+            for (size_t i = ChunkSize; i > 0; i--)
+            {
+                uint32_t Index = _Capacity + i - 1;
+
+                At(Index).Next = FreeSlot;
+                FreeSlot = Index;
+            }
+
+            _Capacity += ChunkSize;
+        }
+    };
+}
@@ -1,14 +1,18 @@
 #pragma once
 
 #include <string>
+#include <climits>
+#include <utility>
 
 #include <File.hpp>
 #include <Duration.hpp>
 #include <Format/Stream.hpp>
+#include <Async/EventLoop.hpp>
 #include <Network/HTTP/Response.hpp>
 #include <Network/HTTP/Request.hpp>
 #include <Network/TLSContext.hpp>
 #include <Network/HTTP/Parser.hpp>
+#include <Network/HTTP/Serializer.hpp>
 
 namespace Core
 {
@@ -25,6 +29,8 @@ namespace Core
                     size_t FileContentLength;
                 };
 
+                struct Deferred;
+
                 struct Context : public Async::EventLoop::Context
                 {
                     Network::EndPoint const &Target;
@@ -50,18 +56,24 @@ namespace Core
                     {
                         Loop.AssertPermission();
 
-                        HandlerAs<HTTP::Connection>().AppendResponse(Response, std::move(file), FileLength);
+                        auto &Self = HandlerAs<HTTP::Connection>();
+
+                        Self.AppendResponse(Response, std::move(file), FileLength);
 
-                        ListenFor(ePoll::In | ePoll::Out);
+                        Self.Push(*this);
+                        Self.Resume(*this);
                     }
 
                     inline void SendBuffer(Iterable::Queue<char> Buffer, File file = {}, size_t FileLength = 0) const
                     {
                         Loop.AssertPermission();
 
-                        HandlerAs<HTTP::Connection>().AppendBuffer(std::move(Buffer), std::move(file), FileLength);
+                        auto &Self = HandlerAs<HTTP::Connection>();
+
+                        Self.AppendBuffer(std::move(Buffer), std::move(file), FileLength);
 
-                        ListenFor(ePoll::In | ePoll::Out);
+                        Self.Push(*this);
+                        Self.Resume(*this);
                     }
 
                     inline bool WillClose()
@@ -69,6 +81,16 @@ namespace Core
                         return HandlerAs<HTTP::Connection>().ShouldClose;
                     }
 
+                    /**
+                     * @brief Token for answering this request later from any thread
+                     * The request stays parsed until its response is queued, so it
+                     * may be read from the thread that completes the token
+                     */
+                    inline Deferred Defer() const
+                    {
+                        return {&Loop, Self.Id, HandlerAs<HTTP::Connection>().Sequence};
+                    }
+
                     template <typename TCallback>
                     inline void OnRemove(TCallback &&Callback)
                     {
@@ -88,19 +110,87 @@ namespace Core
                     }
                 };
 
+                /**
+                 * @brief Copyable handle to a connection whose response is sent later,
+                 * completions from other threads are posted to the owning loop and
+                 * dropped there if the connection is already gone or its request
+                 * was answered already
+                 */
+                struct Deferred
+                {
+                    Async::EventLoop *Loop = nullptr;
+                    Async::EventLoop::Handle Id;
+                    uint64_t Sequence = 0;
+
+                    inline void SendResponse(HTTP::Response Response, File file = {}, size_t FileLength = 0) const
+                    {
+                        Complete(
+                            [Response = std::move(Response), file = std::move(file), FileLength](Connection::Context const &Context) mutable
+                            {
+                                Context.SendResponse(Response, std::move(file), FileLength);
+                            });
+                    }
+
+                    inline void SendBuffer(Iterable::Queue<char> Buffer, File file = {}, size_t FileLength = 0) const
+                    {
+                        Complete(
+                            [Buffer = std::move(Buffer), file = std::move(file), FileLength](Connection::Context const &Context) mutable
+                            {
+                                Context.SendBuffer(std::move(Buffer), std::move(file), FileLength);
+                            });
+                    }
+
+                    inline explicit operator bool() const
+                    {
+                        return Loop != nullptr;
+                    }
+
+                private:
+                    template <typename TCallback>
+                    inline void Complete(TCallback &&Callback) const
+                    {
+                        Loop->Execute(
+                            [Loop = Loop, Id = Id, Sequence = Sequence, Callback = std::forward<TCallback>(Callback)]() mutable
+                            {
+                                // The handle's generation no longer matches once the connection is removed
+
+                                Async::EventLoop::Entry *Self = Loop->Find(Id);
+
+                                if (!Self)
+                                    return;
+
+                                auto &Handler = *Self->CallbackAs<Connection>();
+
+                                // A second completion would otherwise answer the request pipelined behind
+
+                                if (!Handler.Awaiting || Handler.Sequence != Sequence)
+                                    return;
+
+                                Callback(Connection::Context{{*Loop, *Self}, Handler.Target, Handler.Source});
+                            });
+                    }
+                };
+
                 struct Settings
                 {
                     size_t MaxHeaderSize;
                     size_t MaxBodySize;
                     size_t RequestBufferSize;
-                    size_t ResponseBufferSize;
                     Core::Function<void(Context &, Network::HTTP::Response &)> OnError;
                     Core::Function<void(Context &, Network::HTTP::Request &)> OnRequest;
                     bool NoDelay;
                     bool RawContent;
                     Duration Timeout;
+                    bool EdgeTriggered;
+                    bool ZeroCopy;
                 };
 
+                /**
+                 * @brief Interest of edge-triggered connections, registered once
+                 * and never modified since reads and writes run until EAGAIN
+                 */
+                static constexpr ePoll::Event EdgeEvents = ePoll::In | ePoll::Out | ePoll::ReadHangUp | ePoll::EdgeTriggered;
+
                 Network::EndPoint Target;
                 Network::EndPoint Source;
 
@@ -115,9 +205,34 @@ namespace Core
                 Core::Function<void()> OnSent;
 
                 // @todo Fix this limitations
-                HTTP::Parser<HTTP::Request> Parser{Setting.MaxHeaderSize, Setting.MaxBodySize, Setting.RequestBufferSize, IBuffer, Setting.RawContent};
+                HTTP::Parser<HTTP::Request> Parser{Setting.MaxHeaderSize, Setting.MaxBodySize, Setting.RequestBufferSize, IBuffer, Setting.RawContent, Setting.ZeroCopy};
                 bool ShouldClose = false;
 
+                // Set while Push runs so sends made from OnSent join its loop
+
+                bool Pushing = false;
+
+                // Set from a request's dispatch until its response is queued, the
+                // requests pipelined behind it wait in IBuffer so responses keep
+                // their order when a handler answers later
+
+                bool Awaiting = false;
+                bool Dispatching = false;
+
+                // Numbers the dispatched requests so a deferred token only answers its own
+
+                uint64_t Sequence = 0;
+
+                // Set when an edge-triggered read stopped for a pending response,
+                // what arrived since raises no other edge so Resume reads it
+
+                bool Paused = false;
+
+                // Set once writing failed and the socket was shut down, requests
+                // still buffered are dropped since nothing could answer them
+
+                bool Broken = false;
+
                 Connection(Network::EndPoint const &target, Network::EndPoint const &source, Settings &setting)
                     : Target(target),
                       Source(source),
@@ -201,33 +316,28 @@ namespace Core
 
                 inline void AppendBuffer(Iterable::Queue<char> Buffer, File file = {}, size_t FileLength = 0)
                 {
+                    // A deferred request stays parsed until its response is queued,
+                    // Dispatch resets the parser for requests answered right away
+
+                    if (std::exchange(Awaiting, false) && !Dispatching && !ShouldClose)
+                        Parser.Reset();
+
                     OBuffer.Insert({std::move(Buffer), std::move(file), FileLength});
                 }
 
                 void AppendResponse(HTTP::Response const &Response, File file = {}, size_t FileLength = 0)
                 {
-                    size_t StringLength = 0;
-                    auto Buffer = Iterable::Queue<char>(Setting.ResponseBufferSize);
-                    Format::Stream Ser(Buffer);
-
-                    // Serialize first line
-
-                    Ser << "HTTP/" << Response.Version << ' ' << std::to_string(static_cast<unsigned short>(Response.Status)) << ' ' << Response.Brief << "\r\n";
-
-                    // Serialize headers
-
-                    for (auto const &[k, v] : Response.Headers)
-                        Ser << k << ": " << v << "\r\n";
-
                     // Handle keep-alive
 
+                    std::string_view Extra;
+
                     if (!this->ShouldClose && Response.Version == HTTP::HTTP10)
                     {
-                        Ser << "connection: keep-alive\r\n";
+                        Extra = "connection: keep-alive\r\n";
                     }
                     else if (this->ShouldClose && Response.Version == HTTP::HTTP11)
                     {
-                        Ser << "connection: close\r\n";
+                        Extra = "connection: close\r\n";
                     }
 
                     // Calculate length
@@ -236,30 +346,32 @@ namespace Core
                     {
                         FileLength = FileLength ? FileLength : file.BytesLeft();
                     }
-                    else
-                    {
-                        StringLength = Response.Content.length();
-                    }
-
-                    if (Response.Headers.find("content-length") == Response.Headers.end())
-                        Ser << "content-length: " << std::to_string(FileLength + StringLength) << "\r\n";
-
-                    Response.SetCookies.ForEach(
-                        [&](auto const &Cookie)
-                        {
-                            Ser << "set-cookie: " << Cookie << "\r\n";
-                        });
-
-                    Ser << "\r\n"
-                        << Response.Content;
 
-                    AppendBuffer(std::move(Buffer), std::move(file), FileLength);
+                    AppendBuffer(Serializer::Serialize(Response, Extra, file ? FileLength : Response.Content.length()), std::move(file), FileLength);
                 }
-                
+
                 void operator()(Async::EventLoop::Context &Context, ePoll::Entry &Item)
                 {
                     Connection::Context ConnContext{Context, Target, Source};
 
+                    if (Setting.EdgeTriggered)
+                    {
+                        if (Item.Happened(ePoll::HangUp) || Item.Happened(ePoll::Error) ||
+                            (Item.Happened(ePoll::In | ePoll::UrgentIn | ePoll::ReadHangUp) && !OnRead(ConnContext)))
+                        {
+                            Context.Remove();
+                            return;
+                        }
+
+                        // Output the socket didn't take earlier resumes on the Out edge
+
+                        if (Item.Happened(ePoll::Out) && !OBuffer.IsEmpty())
+                            Push(ConnContext);
+
+                        Context.Reschedule(Setting.Timeout);
+                        return;
+                    }
+
                     if (Item.Happened(ePoll::HangUp) || Item.Happened(ePoll::Error) ||
                         ((Item.Happened(ePoll::In) || Item.Happened(ePoll::UrgentIn)) && !OnRead(ConnContext)) ||
                         (Item.Happened(ePoll::Out) && !OnWrite(ConnContext)))
@@ -271,158 +383,362 @@ namespace Core
                     Context.Reschedule(Setting.Timeout);
                 }
 
+                /**
+                 * @brief Reads into the input buffer
+                 * @return Bytes read, 0 if it would block and -1 on end of stream or error
+                 */
+                ssize_t Receive(Network::Socket &Client)
+                {
+                    Format::Stream Stream(IBuffer);
+
+                    static constexpr size_t Threshold = 1024 * 2;
+                    size_t Free = Stream.Queue.IsFree();
+
+                    if (Free < Threshold)
+                        Stream.Queue.IncreaseCapacity(Threshold - Free);
+
+                    if (SSL)
+                        return SSL.Read(Stream);
+
+                    struct iovec Vectors[2];
+                    ssize_t Result = readv(Client.INode(), Vectors, IBuffer.EmptyVectors(Vectors));
+
+                    if (Result > 0)
+                    {
+                        IBuffer.AdvanceTail(Result);
+                        return Result;
+                    }
+
+                    return (Result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) ? 0 : -1;
+                }
+
                 bool OnRead(Connection::Context &Context)
                 {
                     Network::Socket &Client = static_cast<Network::Socket &>(Context.Self.File);
 
-                    // @todo Optimize parser by giving it parsing error callbacks so we
-                    // dont need try catch block
+                    // Level-triggered connections read once per event while edge-triggered
+                    // ones keep going until the socket would block, no other event follows
 
-                    try
+                    do
                     {
-                        Format::Stream Stream(IBuffer);
+                        ssize_t Result = Receive(Client);
 
-                        static constexpr size_t Threshold = 1024 * 2;
-                        size_t Free = Stream.Queue.IsFree();
+                        if (Result < 0)
+                        {
+                            // Output still queued or owed on a closing connection
+                            // shuts the socket down once Push is done with it
 
-                        if (Free < Threshold)
-                            Stream.Queue.IncreaseCapacity(Threshold - Free);
+                            if (!Setting.EdgeTriggered || (OBuffer.IsEmpty() && !ShouldClose))
+                                return false;
 
-                        if ((SSL ? SSL.Read(Stream) : Client.Read(Stream)) <= 0)
-                        {
-                            return false;
+                            ShouldClose = true;
+                            return true;
                         }
 
-                        Parser();
+                        if (Result == 0)
+                            return true;
 
-                        if (Parser.RequiresContinue100)
-                        {
-                            return Continue100(Context);
-                        }
-                    }
-                    catch (HTTP::Status Method)
-                    {
-                        auto Response = HTTP::Response::From(Parser.Result.Version.empty() ? HTTP10 : Parser.Result.Version, Method, {{"Connection", "close"}}, "");
+                        if (!Dispatch(Context))
+                            return false;
 
-                        if (Setting.OnError)
-                            Setting.OnError(Context, Response);
+                        // Reading stops while a response is pending, the requests behind
+                        // it would only pile up in IBuffer
 
-                        AppendResponse(Response);
+                    } while (Setting.EdgeTriggered && !ShouldClose && !Awaiting);
 
-                        Context.ListenFor(ePoll::Out);
+                    Paused = Setting.EdgeTriggered && Awaiting;
 
-                        ShouldClose = true;
+                    return true;
+                }
 
+                /**
+                 * @brief Parses and handles every complete request in IBuffer in one pass,
+                 * stopping at one whose response isn't queued yet
+                 * @return false if the connection failed
+                 */
+                bool Dispatch(Connection::Context &Context)
+                {
+                    if (Dispatching)
                         return true;
-                    }
 
-                    if (!Parser.IsFinished())
-                        return true;
+                    Network::Socket &Client = static_cast<Network::Socket &>(Context.Self.File);
+                    bool Alive = true;
 
-                    // Decide if we should keep the connection
+                    Dispatching = true;
 
-                    auto It = Parser.Result.Headers.find("Connection");
-                    auto End = Parser.Result.Headers.end();
+                    while (!Awaiting && !ShouldClose && !Broken && !IBuffer.IsEmpty())
+                    {
+                        // @todo Optimize parser by giving it parsing error callbacks so we
+                        // dont need try catch block
 
-                    // @todo Optimize this
+                        try
+                        {
+                            Parser();
 
-                    {
-                        std::string ConnectionValue;
+                            if (Parser.RequiresContinue100)
+                            {
+                                if (!(Alive = Continue100(Context)))
+                                    break;
 
-                        if (It != End)
+                                Parser.RequiresContinue100 = false;
+                            }
+                        }
+                        catch (HTTP::Status Method)
                         {
-                            // @todo Optimize this
+                            auto Response = HTTP::Response::From(Parser.Result.Version.empty() ? HTTP10 : Parser.Result.Version, Method, {{"Connection", "close"}}, "");
 
-                            ConnectionValue.resize(It->second.length());
+                            if (Setting.OnError)
+                                Setting.OnError(Context, Response);
 
-                            std::transform(
-                                It->second.begin(),
-                                It->second.end(),
-                                ConnectionValue.begin(),
-                                [](auto c)
-                                {
-                                    return std::tolower(c);
-                                });
+                            AppendResponse(Response);
+
+                            ShouldClose = true;
+
+                            Alive = Push(Context);
+
+                            break;
                         }
 
-                        // @todo Optimize this
+                        if (!Parser.IsFinished())
+                            break;
+
+                        // Decide if we should keep the connection
 
-                        if ((Parser.Result.Version == HTTP::HTTP10 && ConnectionValue != "keep-alive") ||
-                            (Parser.Result.Version == HTTP::HTTP11 && ConnectionValue == "close"))
                         {
-                            Client.ShutDown(Network::Socket::ShutdownRead);
-                            ShouldClose = true;
+                            std::string_view ConnectionValue = Parser.Result.Header(HeaderId::Connection).value_or("");
+
+                            if ((Parser.Result.Version == HTTP::HTTP10 && !KnownHeaders::Contains(ConnectionValue, "keep-alive")) ||
+                                (Parser.Result.Version == HTTP::HTTP11 && KnownHeaders::Contains(ConnectionValue, "close")))
+                            {
+                                Client.ShutDown(Network::Socket::ShutdownRead);
+                                ShouldClose = true;
+                            }
                         }
+
+                        Awaiting = true;
+                        Sequence++;
+
+                        Setting.OnRequest(Context, Parser.Result);
+
+                        if (OnReceived)
+                            OnReceived();
+
+                        if (!Awaiting && !ShouldClose)
+                            Parser.Reset();
                     }
 
-                    Setting.OnRequest(Context, Parser.Result);
+                    Dispatching = false;
 
-                    if (OnReceived)
-                        OnReceived();
+                    // A handler's send may have failed on the way
 
-                    if (!ShouldClose)
-                        Parser.Reset();
+                    if (Broken)
+                        return false;
 
-                    return true;
+                    if (!Setting.EdgeTriggered)
+                        Context.ListenFor(Interest());
+
+                    return Alive;
+                }
+
+                /**
+                 * @brief Lets the requests pipelined behind a late response through
+                 */
+                void Resume(Connection::Context const &Context)
+                {
+                    if (Dispatching || Awaiting || ShouldClose || (IBuffer.IsEmpty() && !Paused))
+                        return;
+
+                    Connection::Context Copy = Context;
+                    bool Alive = Dispatch(Copy);
+
+                    if (Alive && !Awaiting && !ShouldClose && std::exchange(Paused, false))
+                        Alive = OnRead(Copy);
+
+                    if (!Alive)
+                        ::shutdown(Copy.Self.File.INode(), Network::Socket::ShutdownBoth);
+                }
+
+                /**
+                 * @brief Level-triggered interest, reads pause while a response is pending
+                 */
+                inline ePoll::Event Interest() const
+                {
+                    ePoll::Event Events = 0;
+
+                    if (!OBuffer.IsEmpty())
+                        Events |= ePoll::Out;
+
+                    if (!ShouldClose && !Awaiting)
+                        Events |= ePoll::In;
+
+                    return Events;
                 }
 
                 bool OnWrite(Connection::Context &Context)
                 {
                     Network::Socket &Client = static_cast<Network::Socket &>(Context.Self.File);
 
-                    // If there is nothing to send
+                    if (!Flush(Client))
+                        return false;
+
+                    // Wait for the socket to take the rest
+
+                    if (!OBuffer.IsEmpty())
+                        return true;
 
-                    if (OBuffer.IsEmpty())
+                    if (ShouldClose)
+                        return false;
+
+                    OBuffer.Free();
+                    Context.ListenFor(Interest());
+
+                    if (OnSent)
+                        OnSent();
+
+                    return true;
+                }
+
+                /**
+                 * @brief Writes queued output until it's drained or the socket would block
+                 * @return false if writing failed
+                 */
+                bool Flush(Network::Socket &Client)
+                {
+                    try
                     {
-                        if (ShouldClose)
+                        while (!OBuffer.IsEmpty())
                         {
-                            return false;
-                        }
+                            auto &Item = OBuffer.Head();
 
-                        OBuffer.Free();
-                        Context.ListenFor(ePoll::In);
+                            if (!Item.Buffer.IsEmpty())
+                            {
+                                ssize_t Result;
 
-                        if (OnSent)
-                            OnSent();
+                                if (SSL)
+                                {
+                                    Format::Stream Stream(Item.Buffer);
+                                    Result = SSL.Write(Stream);
+                                }
+                                else
+                                {
+                                    Result = Gather(Client);
+                                }
 
-                        return true;
+                                if (Result < 0)
+                                    return false;
+
+                                if (Result == 0)
+                                    return true;
+
+                                continue;
+                            }
+
+                            while (Item.FileContentLength)
+                            {
+                                ssize_t Result = SSL ? SSL.SendFile(Item.FilePtr, Item.FileContentLength) : Client.SendFile(Item.FilePtr, Item.FileContentLength);
+
+                                if (Result == 0)
+                                    return true;
+
+                                Item.FileContentLength -= Result;
+                            }
+
+                            OBuffer.Take();
+                        }
+                    }
+                    catch (std::runtime_error const &)
+                    {
+                        return false;
                     }
 
-                    auto &Item = OBuffer.Head();
-                    Format::Stream Stream(Item.Buffer);
+                    return true;
+                }
+
+                /**
+                 * @brief Writes the buffers of the queued responses with a single writev,
+                 * up to the first one followed by a file since that goes with sendfile
+                 * @return Bytes written, 0 if the socket would block
+                 */
+                ssize_t Gather(Network::Socket &Client)
+                {
+                    static constexpr size_t MaxVectors = IOV_MAX;
 
-                    // Send data in buffer
+                    struct iovec Vectors[MaxVectors];
+                    size_t Count = 0;
 
-                    if (!Item.Buffer.IsEmpty())
+                    for (size_t i = 0; i < OBuffer.Length() && Count + 2 <= MaxVectors; i++)
                     {
-                        // Write data
+                        auto &Item = OBuffer[i];
 
-                        if ((SSL ? SSL.Write(Stream) : Client.Write(Stream)) <= 0)
-                        {
-                            return false;
-                        }
+                        Count += Item.Buffer.DataVectors(Vectors + Count);
 
-                        if (!Item.Buffer.IsEmpty())
-                            return true;
+                        if (Item.FileContentLength)
+                            break;
                     }
 
-                    // Send file
+                    ssize_t Result = Client.Write(Vectors, Count);
+
+                    // Entries left empty are taken by Flush
 
-                    if (Item.FileContentLength)
+                    for (size_t i = 0, Left = Result; Left; i++)
                     {
-                        if (SSL)
-                            Item.FileContentLength -= SSL.SendFile(Item.FilePtr, Item.FileContentLength);
-                        else
-                            Item.FileContentLength -= Client.SendFile(Item.FilePtr, Item.FileContentLength);
+                        auto &Buffer = OBuffer[i].Buffer;
+                        size_t Written = std::min(Left, Buffer.Length());
+
+                        Buffer.Free(Written);
+                        Left -= Written;
                     }
 
-                    // Pop buffer if we're done
+                    return Result;
+                }
+
+                /**
+                 * @brief Sends queued output right away and only waits on the loop
+                 * for what the socket won't take yet
+                 * Failing or finishing a closing connection shuts the socket down, the
+                 * hang up that follows removes it. Level-triggered connections leave the
+                 * remainder to OnWrite while edge-triggered ones resume on the Out edge.
+                 * @return false if writing failed
+                 */
+                bool Push(Connection::Context const &Context)
+                {
+                    if (Pushing)
+                        return !Broken;
+
+                    Network::Socket &Client = static_cast<Network::Socket &>(Context.Self.File);
+                    bool Alive;
+
+                    Pushing = true;
 
-                    if (Item.Buffer.IsEmpty() && !Item.FileContentLength)
+                    while ((Alive = Flush(Client)) && OBuffer.IsEmpty() && !ShouldClose)
                     {
-                        OBuffer.Take();
+                        OBuffer.Free();
+
+                        if (OnSent)
+                            OnSent();
+
+                        if (OBuffer.IsEmpty())
+                            break;
                     }
 
+                    Pushing = false;
+
+                    bool Done = OBuffer.IsEmpty();
+
+                    if (!Alive || (Done && ShouldClose))
+                    {
+                        // Fails only if the peer is gone already, which reports the hang up anyway
+
+                        ::shutdown(Client.INode(), Network::Socket::ShutdownBoth);
+
+                        Broken |= !Alive;
+
+                        return Alive;
+                    }
+
+                    if (!Setting.EdgeTriggered)
+                        Context.ListenFor(Interest());
+
                     return true;
                 }
             };
@@ -1,12 +1,21 @@
 #pragma once
 
+#include <bit>
+#include <array>
+#include <algorithm>
 #include <string>
 #include <string_view>
 #include <unordered_map>
 #include <map>
+#include <cstdint>
+#include <optional>
 
 #include <Duration.hpp>
+#include <Iterable/List.hpp>
 #include <Iterable/Queue.hpp>
+#include <Format/Stream.hpp>
+#include <Network/HTTP/Scanner.hpp>
+#include <Network/HTTP/KnownHeaders.hpp>
 
 namespace Core::Network::HTTP
 {
@@ -232,6 +241,224 @@ namespace Core::Network::HTTP
         return it->second;
     }
 
+    /**
+     * @brief Header field pointing into the buffer its message was parsed from
+     */
+    struct HeaderView
+    {
+        std::string_view Name;
+        std::string_view Value;
+    };
+
+    /**
+     * @brief Flat list of header views that keeps its capacity across messages,
+     * names keep the sender's case and lookups ignore it
+     */
+    class HeaderViews
+    {
+    public:
+        inline void Add(std::string_view Name, std::string_view Value)
+        {
+            Items.Add(HeaderView{Name, Value});
+        }
+
+        inline size_t Length() const
+        {
+            return Items.Length();
+        }
+
+        inline HeaderView const &operator[](size_t Index) const
+        {
+            return Items[Index];
+        }
+
+        inline HeaderView const *begin() const
+        {
+            return Items.Content();
+        }
+
+        inline HeaderView const *end() const
+        {
+            return Items.Content() + Items.Length();
+        }
+
+        /**
+         * @brief Value of the first field with the given name
+         */
+        std::optional<std::string_view> Find(std::string_view Name) const
+        {
+            for (size_t i = 0; i < Items.Length(); i++)
+            {
+                if (Equals(Items[i].Name, Name))
+                    return Items[i].Value;
+            }
+
+            return std::nullopt;
+        }
+
+        inline bool Contains(std::string_view Name) const
+        {
+            return Find(Name).has_value();
+        }
+
+        /**
+         * @brief Drops every field with the given name
+         */
+        void Remove(std::string_view Name)
+        {
+            size_t Kept = 0;
+
+            for (size_t i = 0; i < Items.Length(); i++)
+            {
+                if (!Equals(Items[i].Name, Name))
+                    Items[Kept++] = Items[i];
+            }
+
+            Items.Length(Kept);
+        }
+
+        inline void Clear()
+        {
+            Items.Length(0);
+        }
+
+        /**
+         * @brief Moves the views to a buffer that now starts at Base, From being
+         * the address the old buffer started at
+         */
+        void Rebase(uintptr_t From, char const *Base)
+        {
+            for (size_t i = 0; i < Items.Length(); i++)
+            {
+                Items[i].Name = Move(Items[i].Name, From, Base);
+                Items[i].Value = Move(Items[i].Value, From, Base);
+            }
+        }
+
+        /**
+         * @brief Owning copy keyed by lowercase names like Message::Headers,
+         * repeated cookie fields are joined with ';'
+         */
+        std::unordered_map<std::string, std::string> Materialize() const
+        {
+            std::unordered_map<std::string, std::string> Result;
+
+            Result.reserve(Items.Length());
+
+            for (size_t i = 0; i < Items.Length(); i++)
+            {
+                std::string Key(Items[i].Name);
+
+                std::transform(
+                    Key.begin(),
+                    Key.end(),
+                    Key.begin(),
+                    [](auto c)
+                    {
+                        return std::tolower(c);
+                    });
+
+                auto [It, Inserted] = Result.try_emplace(std::move(Key), Items[i].Value);
+
+                if (Inserted)
+                    continue;
+
+                if (It->first == "cookie")
+                    (It->second += ';') += Items[i].Value;
+                else
+                    It->second = Items[i].Value;
+            }
+
+            return Result;
+        }
+
+        static inline bool Equals(std::string_view First, std::string_view Second)
+        {
+            return KnownHeaders::Equals(First, Second);
+        }
+
+        static inline std::string_view Move(std::string_view View, uintptr_t From, char const *Base)
+        {
+            return {Base + (reinterpret_cast<uintptr_t>(View.data()) - From), View.length()};
+        }
+
+    private:
+        Iterable::List<HeaderView> Items = Iterable::List<HeaderView>(16);
+    };
+
+    /**
+     * @brief Values of the known headers a parser found, one slot per HeaderId
+     * with a mask of the filled ones. Slots view the message's own storage so
+     * a copy starts out unindexed.
+     */
+    class HeaderIndex
+    {
+    public:
+        // Set while the slots reflect every header of the message
+
+        bool Indexed = false;
+
+        HeaderIndex() = default;
+        HeaderIndex(HeaderIndex const &) {}
+        HeaderIndex(HeaderIndex &&Other) = default;
+
+        HeaderIndex &operator=(HeaderIndex const &)
+        {
+            Clear();
+            return *this;
+        }
+
+        HeaderIndex &operator=(HeaderIndex &&Other) = default;
+
+        inline void Set(HeaderId Id, std::string_view Value)
+        {
+            Slots[static_cast<size_t>(Id)] = Value;
+            Present |= Bit(Id);
+        }
+
+        inline void Unset(HeaderId Id)
+        {
+            Present &= ~Bit(Id);
+        }
+
+        inline bool Has(HeaderId Id) const
+        {
+            return Present & Bit(Id);
+        }
+
+        inline std::optional<std::string_view> Get(HeaderId Id) const
+        {
+            if (!Has(Id))
+                return std::nullopt;
+
+            return Slots[static_cast<size_t>(Id)];
+        }
+
+        inline void Clear(bool indexed = false)
+        {
+            Present = 0;
+            Indexed = indexed;
+        }
+
+        void Rebase(uintptr_t From, char const *Base)
+        {
+            for (uint64_t Mask = Present; Mask; Mask &= Mask - 1)
+            {
+                auto &Slot = Slots[std::countr_zero(Mask)];
+                Slot = HeaderViews::Move(Slot, From, Base);
+            }
+        }
+
+    private:
+        uint64_t Present = 0;
+        std::array<std::string_view, KnownHeaders::Count> Slots;
+
+        static constexpr inline uint64_t Bit(HeaderId Id)
+        {
+            return uint64_t(1) << static_cast<size_t>(Id);
+        }
+    };
+
     class Message
     {
     public:
@@ -239,6 +466,52 @@ namespace Core::Network::HTTP
         std::unordered_map<std::string, std::string> Headers;
         std::string Content;
 
+        // Views into the receive buffer, filled instead of Headers and Content
+        // by parsers in zero-copy mode and valid until the parser resets
+
+        HeaderViews Fields;
+        std::string_view ContentView;
+
+        // Known headers found by the parse in either mode
+
+        HeaderIndex Index;
+
+        /**
+         * @brief Value of a known header, taken from its slot when the message
+         * was parsed and looked up by name otherwise, e.g. after being copied
+         */
+        std::optional<std::string_view> Header(HeaderId Id) const
+        {
+            if (Index.Indexed)
+                return Index.Get(Id);
+
+            if (Headers.empty())
+                return Fields.Find(KnownHeaders::Name(Id));
+
+            auto It = Headers.find(Key(Id));
+
+            if (It == Headers.end())
+                return std::nullopt;
+
+            return It->second;
+        }
+
+        /**
+         * @brief Copies the views into Headers and Content so the message
+         * outlives the receive buffer
+         */
+        void Materialize()
+        {
+            if (Fields.Length())
+            {
+                Headers = Fields.Materialize();
+                Index.Clear();
+            }
+
+            if (ContentView.data() && ContentView.data() != Content.data())
+                Content = ContentView;
+        }
+
         size_t ParseHeaders(std::string_view Text, size_t Start, size_t End = 0)
         {
             size_t Cursor = Start;
@@ -248,16 +521,25 @@ namespace Core::Network::HTTP
             Iterable::Queue<char> CookieQueue;
             Format::Stream CookieStream(CookieQueue);
 
+            Index.Clear(true);
+
             if (End == 0)
             {
                 BodyStart = Text.find("\r\n\r\n");
                 BodyStart = BodyStart == std::string::npos ? Text.length() : BodyStart;
             }
 
-            while (Cursor < BodyStart && (CursorTmp = Text.find(':', Cursor)) < BodyStart)
+            while (Cursor < BodyStart && Text.compare(Cursor, 2, "\r\n") != 0)
             {
                 // Find key
 
+                CursorTmp = Scanner::TokenEnd(Text, Cursor);
+
+                if (CursorTmp >= BodyStart || CursorTmp == Cursor || Text[CursorTmp] != ':')
+                {
+                    throw std::invalid_argument("Invalid header name");
+                }
+
                 auto HeaderKeyView = Text.substr(Cursor, CursorTmp - Cursor);
                 Cursor = Text[CursorTmp + 1] == ' ' ? CursorTmp + 2 : CursorTmp + 1;
 
@@ -278,7 +560,13 @@ namespace Core::Network::HTTP
 
                 // Find value
 
-                CursorTmp = Text.find('\r', Cursor);
+                CursorTmp = Scanner::ValueEnd(Text, Cursor);
+
+                if (CursorTmp == std::string::npos || Text.compare(CursorTmp, 2, "\r\n") != 0)
+                {
+                    throw std::invalid_argument("Invalid header value");
+                }
+
                 std::string HeaderValue(Text.substr(Cursor, CursorTmp - Cursor));
 
                 // Decide on the key
@@ -292,12 +580,11 @@ namespace Core::Network::HTTP
                 }
                 else
                 {
-                    Headers.insert_or_assign(std::move(HeaderKey), std::move(HeaderValue));
-                }
+                    auto Id = KnownHeaders::Find(HeaderKey);
+                    auto [It, Inserted] = Headers.insert_or_assign(std::move(HeaderKey), std::move(HeaderValue));
 
-                if (CursorTmp == std::string::npos)
-                {
-                    break;
+                    if (Id != HeaderId::Unknown)
+                        Index.Set(Id, It->second);
                 }
 
                 Cursor = CursorTmp + 2;
@@ -306,15 +593,79 @@ namespace Core::Network::HTTP
             if (!CookieStream.Queue.IsEmpty())
             {
                 auto [Pointer, Size] = CookieQueue.DataChunk();
-                Headers.insert_or_assign("cookie", std::string{Pointer, Size});
+                auto [It, Inserted] = Headers.insert_or_assign("cookie", std::string{Pointer, Size});
+
+                Index.Set(HeaderId::Cookie, It->second);
             }
 
             return BodyStart + 4;
         }
 
+        /**
+         * @brief Zero-copy version of ParseHeaders filling Fields
+         */
+        size_t ParseHeaderViews(std::string_view Text, size_t Start, size_t End)
+        {
+            size_t Cursor = Start;
+            size_t CursorTmp = 0;
+
+            Index.Clear(true);
+
+            while (Cursor < End && Text.compare(Cursor, 2, "\r\n") != 0)
+            {
+                CursorTmp = Scanner::TokenEnd(Text, Cursor);
+
+                if (CursorTmp >= End || CursorTmp == Cursor || Text[CursorTmp] != ':')
+                    throw std::invalid_argument("Invalid header name");
+
+                auto Name = Text.substr(Cursor, CursorTmp - Cursor);
+                Cursor = Text[CursorTmp + 1] == ' ' ? CursorTmp + 2 : CursorTmp + 1;
+
+                CursorTmp = Scanner::ValueEnd(Text, Cursor);
+
+                if (CursorTmp == std::string::npos || Text.compare(CursorTmp, 2, "\r\n") != 0)
+                    throw std::invalid_argument("Invalid header value");
+
+                auto Value = Text.substr(Cursor, CursorTmp - Cursor);
+                auto Id = KnownHeaders::Find(Name);
+
+                Fields.Add(Name, Value);
+
+                // The last value wins like in Headers, except repeated cookies that can only
+                // be joined by a copy, the slot keeps the first and Fields has them all
+
+                if (Id != HeaderId::Unknown && (Id != HeaderId::Cookie || !Index.Has(Id)))
+                    Index.Set(Id, Value);
+
+                Cursor = CursorTmp + 2;
+            }
+
+            return End + 4;
+        }
+
         void ParseContent(std::string_view Text, size_t BodyIndex)
         {
             Content = std::string{Text.substr(BodyIndex)};
         }
+
+    private:
+        /**
+         * @brief Name of a known header as a key of Headers, built once so
+         * lookups don't allocate
+         */
+        static std::string const &Key(HeaderId Id)
+        {
+            static auto const Keys = []
+            {
+                std::array<std::string, KnownHeaders::Count> Result;
+
+                for (size_t i = 0; i < Result.size(); i++)
+                    Result[i] = KnownHeaders::Name(static_cast<HeaderId>(i));
+
+                return Result;
+            }();
+
+            return Keys[static_cast<size_t>(Id)];
+        }
     };
 }
\ No newline at end of file
@@ -0,0 +1,280 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace Core::Network::HTTP
+{
+    /**
+     * @brief Standard header fields recognized while parsing, at most 64
+     * so a message can track the ones it has in a single mask
+     */
+    enum class HeaderId : uint8_t
+    {
+        Unknown = 0,
+        Accept,
+        AcceptCharset,
+        AcceptEncoding,
+        AcceptLanguage,
+        AcceptRanges,
+        Age,
+        Allow,
+        Authorization,
+        CacheControl,
+        Connection,
+        ContentDisposition,
+        ContentEncoding,
+        ContentLanguage,
+        ContentLength,
+        ContentLocation,
+        ContentRange,
+        ContentType,
+        Cookie,
+        Date,
+        ETag,
+        Expect,
+        Expires,
+        Forwarded,
+        From,
+        Host,
+        IfMatch,
+        IfModifiedSince,
+        IfNoneMatch,
+        IfRange,
+        IfUnmodifiedSince,
+        KeepAlive,
+        LastModified,
+        Link,
+        Location,
+        MaxForwards,
+        Origin,
+        Pragma,
+        ProxyAuthenticate,
+        ProxyAuthorization,
+        Range,
+        Referer,
+        RetryAfter,
+        SecWebSocketKey,
+        SecWebSocketVersion,
+        Server,
+        SetCookie,
+        TE,
+        Trailer,
+        TransferEncoding,
+        Upgrade,
+        UserAgent,
+        Vary,
+        Via,
+        WWWAuthenticate,
+        XForwardedFor,
+        XForwardedProto,
+        XRequestedWith,
+        Count
+    };
+
+    /**
+     * @brief Maps header names to HeaderId through a perfect hash whose
+     * seed is searched at compile time, a lookup hashes three characters
+     * and the length then confirms with one case-insensitive compare
+     */
+    class KnownHeaders
+    {
+    public:
+        static constexpr size_t Count = static_cast<size_t>(HeaderId::Count);
+
+        static_assert(Count <= 64, "Known headers must fit a 64 bit mask");
+
+        // Lowercase names in HeaderId order
+
+        static constexpr std::array<std::string_view, Count> Names{
+            "",
+            "accept",
+            "accept-charset",
+            "accept-encoding",
+            "accept-language",
+            "accept-ranges",
+            "age",
+            "allow",
+            "authorization",
+            "cache-control",
+            "connection",
+            "content-disposition",
+            "content-encoding",
+            "content-language",
+            "content-length",
+            "content-location",
+            "content-range",
+            "content-type",
+            "cookie",
+            "date",
+            "etag",
+            "expect",
+            "expires",
+            "forwarded",
+            "from",
+            "host",
+            "if-match",
+            "if-modified-since",
+            "if-none-match",
+            "if-range",
+            "if-unmodified-since",
+            "keep-alive",
+            "last-modified",
+            "link",
+            "location",
+            "max-forwards",
+            "origin",
+            "pragma",
+            "proxy-authenticate",
+            "proxy-authorization",
+            "range",
+            "referer",
+            "retry-after",
+            "sec-websocket-key",
+            "sec-websocket-version",
+            "server",
+            "set-cookie",
+            "te",
+            "trailer",
+            "transfer-encoding",
+            "upgrade",
+            "user-agent",
+            "vary",
+            "via",
+            "www-authenticate",
+            "x-forwarded-for",
+            "x-forwarded-proto",
+            "x-requested-with",
+        };
+
+        static constexpr inline std::string_view Name(HeaderId Id)
+        {
+            return Names[static_cast<size_t>(Id)];
+        }
+
+        static constexpr HeaderId Find(std::string_view Name)
+        {
+            if (Name.empty() || Name.length() > MaxLength)
+                return HeaderId::Unknown;
+
+            auto Id = Table[Hash(Name, Seed)];
+
+            return Equals(Names[Id], Name) ? static_cast<HeaderId>(Id) : HeaderId::Unknown;
+        }
+
+        /**
+         * @brief Compares ASCII case-insensitively
+         */
+        static constexpr bool Equals(std::string_view First, std::string_view Second)
+        {
+            if (First.length() != Second.length())
+                return false;
+
+            for (size_t i = 0; i < First.length(); i++)
+            {
+                if (Lower(First[i]) != Lower(Second[i]))
+                    return false;
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief Whether a comma separated field value such as Connection's
+         * holds the token, ignoring case and optional whitespace
+         */
+        static constexpr bool Contains(std::string_view List, std::string_view Token)
+        {
+            while (!List.empty())
+            {
+                size_t Comma = List.find(',');
+                auto Item = List.substr(0, Comma);
+
+                while (!Item.empty() && (Item.front() == ' ' || Item.front() == '\t'))
+                    Item.remove_prefix(1);
+
+                while (!Item.empty() && (Item.back() == ' ' || Item.back() == '\t'))
+                    Item.remove_suffix(1);
+
+                if (Equals(Item, Token))
+                    return true;
+
+                if (Comma == std::string_view::npos)
+                    break;
+
+                List.remove_prefix(Comma + 1);
+            }
+
+            return false;
+        }
+
+    private:
+        static constexpr size_t TableSize = 256;
+
+        static constexpr inline char Lower(char Character)
+        {
+            return Character >= 'A' && Character <= 'Z' ? Character + ('a' - 'A') : Character;
+        }
+
+        static constexpr uint32_t Hash(std::string_view Name, uint32_t Seed)
+        {
+            uint32_t Length = static_cast<uint32_t>(Name.length());
+            uint32_t Value = Seed ^ (Length * 0x9E3779B1u);
+
+            Value = (Value ^ static_cast<uint8_t>(Lower(Name[0]))) * 0x01000193u;
+            Value = (Value ^ static_cast<uint8_t>(Lower(Name[Length / 2]))) * 0x01000193u;
+            Value = (Value ^ static_cast<uint8_t>(Lower(Name[Length - 1]))) * 0x01000193u;
+
+            return (Value ^ (Value >> 16)) % TableSize;
+        }
+
+        static const size_t MaxLength;
+        static const uint32_t Seed;
+        static const std::array<uint8_t, TableSize> Table;
+    };
+
+    // Defined out of the class since evaluating Hash needs the class complete
+
+    inline constexpr size_t KnownHeaders::MaxLength = []
+    {
+        size_t Result = 0;
+
+        for (auto Item : Names)
+            Result = Item.length() > Result ? Item.length() : Result;
+
+        return Result;
+    }();
+
+    inline constexpr uint32_t KnownHeaders::Seed = []
+    {
+        for (uint32_t Candidate = 0; Candidate < 100000; Candidate++)
+        {
+            bool Used[TableSize]{};
+            bool Unique = true;
+
+            for (size_t i = 1; i < Count && Unique; i++)
+            {
+                auto Slot = Hash(Names[i], Candidate);
+
+                Unique = !Used[Slot];
+                Used[Slot] = true;
+            }
+
+            if (Unique)
+                return Candidate;
+        }
+
+        throw "No perfect hash seed for the known headers";
+    }();
+
+    inline constexpr std::array<uint8_t, KnownHeaders::TableSize> KnownHeaders::Table = []
+    {
+        std::array<uint8_t, TableSize> Result{};
+
+        for (size_t i = 1; i < Count; i++)
+            Result[Hash(Names[i], Seed)] = static_cast<uint8_t>(i);
+
+        return Result;
+    }();
+}
@@ -171,9 +171,11 @@ namespace Core::Network::HTTP::Modules
             return static_cast<T &>(*this);
         }
 
-        inline T &ResponseBufferSize(size_t Size)
+        /**
+         * @brief Has no effect, responses are serialized into buffers of their exact size
+         */
+        [[deprecated("Responses are sized exactly, the setting is ignored")]] inline T &ResponseBufferSize(size_t)
         {
-            Settings.ResponseBufferSize = Size;
             return static_cast<T &>(*this);
         }
 
@@ -183,39 +185,49 @@ namespace Core::Network::HTTP::Modules
             return static_cast<T &>(*this);
         }
 
+        /**
+         * @brief Registers connections edge-triggered for reads and writes at once,
+         * avoiding the interest changes level-triggered connections go through
+         */
+        inline T &EdgeTriggered(bool Enable = true)
+        {
+            Settings.EdgeTriggered = Enable;
+            return static_cast<T &>(*this);
+        }
+
+        /**
+         * @brief Parses requests into views over the receive buffer, handlers
+         * read PathView, Fields and ContentView and call Materialize to keep them
+         */
+        inline T &ZeroCopy(bool Enable = true)
+        {
+            Settings.ZeroCopy = Enable;
+            return static_cast<T &>(*this);
+        }
+
+        /**
+         * @brief Most connections accepted per listener wakeup
+         */
+        inline T &AcceptBatch(size_t Count)
+        {
+            AcceptLimit = Count ? Count : 1;
+            return static_cast<T &>(*this);
+        }
+
         inline auto &Listen(Network::EndPoint const &endPoint)
         {
             return static_cast<T &>(*this).ListenWith(
                 endPoint,
-                [this, endPoint, Counter = 0ull](Async::EventLoop::Context &Context, ePoll::Entry &) mutable
+                [this, endPoint](Async::EventLoop::Context &Context, ePoll::Entry &)
                 {
-                    Network::Socket &Router = static_cast<Network::Socket &>(Context.Self.File);
-
-                    auto [Client, Info] = Router.Accept();
-
-                    if (!Client || !static_cast<T &>(*this).TryIncrementConnectionCount())
-                        return;
-
-                    // Set Non-blocking
-
-                    Client.Blocking(false);
-
-                    // Set NoDelay
-
-                    if (Settings.NoDelay)
-                        Client.SetOptions(IPPROTO_TCP, TCP_NODELAY, static_cast<int>(1));
-
-                    static_cast<T &>(*this).ThreadPool()[Counter].Assign(
-                        std::move(Client),
-                        Connection(Info, endPoint, Settings),
-                        // Async::EventLoop::CallbackType::From<Connection>(Info, endPoint, Settings),
-                        [this]
+                    AcceptAll(
+                        Context,
+                        [this, &endPoint](Network::Socket &, Network::EndPoint const &Info) -> Async::EventLoop::CallbackType
                         {
-                            static_cast<T &>(*this).DecrementConnectionCount();
+                            // return Async::EventLoop::CallbackType::From<Connection>(Info, endPoint, Settings);
+                            return Connection(Info, endPoint, Settings);
                         },
-                        Settings.Timeout);
-
-                    Counter = static_cast<T &>(*this).ThreadPool().Length() ? (Counter + 1) % static_cast<T &>(*this).ThreadPool().Length() : 0;
+                        Events());
                 },
                 nullptr);
         }
@@ -224,98 +236,128 @@ namespace Core::Network::HTTP::Modules
         {
             return static_cast<T &>(*this).ListenWith(
                 endPoint,
-                [this, endPoint, Counter = 0ull, TLS = TLSContext(Certification, Key)](Async::EventLoop::Context &Context, ePoll::Entry &) mutable
+                [this, endPoint, TLS = TLSContext(Certification, Key)](Async::EventLoop::Context &Context, ePoll::Entry &) mutable
                 {
-                    Network::Socket &Router = static_cast<Network::Socket &>(Context.Self.File);
-
-                    auto [Client, Info] = Router.Accept();
+                    AcceptAll(
+                        Context,
+                        [this, &endPoint, &TLS](Network::Socket &Client, Network::EndPoint const &Info) -> Async::EventLoop::CallbackType
+                        {
+                            // #ifdef TLS_1_2_VERSION
+                            // if (true /*Settings.KernelTLS*/)
+                            //     Client.SetOptions(SOL_TCP, TCP_ULP, "tls");
+                            // #endif
 
-                    if (!Client || !static_cast<T &>(*this).TryIncrementConnectionCount())
-                        return;
+                            auto SS = TLS.NewSocket();
 
-                    // Set Non-blocking
+                            SS.SetDescriptor(Client);
+                            SS.SetAccept();
+                            // SS.SetVerify(SSL_VERIFY_NONE, nullptr);
 
-                    Client.Blocking(false);
+                            return [this, endPoint, Info = Info, SSL = std::move(SS)](Async::EventLoop::Context &Context, ePoll::Entry &Item) mutable
+                            {
+                                if (Item.Happened(ePoll::HangUp) || Item.Happened(ePoll::Error))
+                                {
+                                    Context.Remove();
+                                    return;
+                                }
+
+                                //
+
+                                auto Result = SSL.Handshake();
+
+                                if (Result == 1)
+                                {
+                                    SSL.ShakeHand = true;
+                                    Context.ListenFor(ePoll::In);
+                                    // Context.Upgrade(Async::EventLoop::CallbackType::From<Connection>(Info, endPoint, Settings, std::move(SSL)), Settings.Timeout);
+                                    Context.Upgrade(Connection(Info, endPoint, Settings, std::move(SSL)), Settings.Timeout, Events());
+                                    return;
+                                }
+
+                                auto Error = SSL.GetError(Result);
+
+                                if (Error == SSL_ERROR_WANT_WRITE)
+                                {
+                                    Context.ListenFor(ePoll::Out | ePoll::In);
+                                }
+                                else if (Error == SSL_ERROR_WANT_READ)
+                                {
+                                    Context.ListenFor(ePoll::In);
+                                }
+                                else
+                                {
+                                    Context.Remove();
+                                }
+                            };
+                        },
+                        ePoll::In);
+                },
+                nullptr);
+        }
 
-                    // Set NoDelay
+    private:
+        size_t AcceptLimit = 64;
 
-                    if (Settings.NoDelay)
-                        Client.SetOptions(IPPROTO_TCP, TCP_NODELAY, 1);
+        inline ePoll::Event Events() const
+        {
+            return Settings.EdgeTriggered ? Connection::EdgeEvents : ePoll::Event(ePoll::In);
+        }
 
-                    // #ifdef TLS_1_2_VERSION
-                    // if (true /*Settings.KernelTLS*/)
-                    //     Client.SetOptions(SOL_TCP, TCP_ULP, "tls");
-                    // #endif
+        /**
+         * @brief Accepts until the queue is drained or the batch limit
+         * is hit, then hands every target loop its share at once
+         */
+        template <typename TBuilder>
+        void AcceptAll(Async::EventLoop::Context &Context, TBuilder &&Builder, ePoll::Event Events)
+        {
+            Network::Socket &Router = static_cast<Network::Socket &>(Context.Self.File);
 
-                    auto SS = TLS.NewSocket();
+            Async::AssignBatch Batch;
 
-                    SS.SetDescriptor(Client);
-                    SS.SetAccept();
-                    // SS.SetVerify(SSL_VERIFY_NONE, nullptr);
+            for (size_t i = 0; i < AcceptLimit; i++)
+            {
+                auto [Client, Info] = Router.TryAccept(SOCK_NONBLOCK | SOCK_CLOEXEC);
 
-                    static_cast<T &>(*this).ThreadPool()[Counter].Assign(
-                        std::move(Client),
-                        [this, endPoint, Info = Info, SSL = std::move(SS)](Async::EventLoop::Context &Context, ePoll::Entry &Item) mutable
-                        {
-                            if (Item.Happened(ePoll::HangUp) || Item.Happened(ePoll::Error))
-                            {
-                                Context.Remove();
-                                return;
-                            }
+                if (!Client)
+                    break;
 
-                            //
+                if (!static_cast<T &>(*this).TryIncrementConnectionCount())
+                    continue;
 
-                            auto Result = SSL.Handshake();
+                // Set NoDelay
 
-                            if (Result == 1)
-                            {
-                                SSL.ShakeHand = true;
-                                Context.ListenFor(ePoll::In);
-                                // Context.Upgrade(Async::EventLoop::CallbackType::From<Connection>(Info, endPoint, Settings, std::move(SSL)), Settings.Timeout);
-                                Context.Upgrade(Connection(Info, endPoint, Settings, std::move(SSL)), Settings.Timeout);
-                                return;
-                            }
+                if (Settings.NoDelay)
+                    Client.SetOptions(IPPROTO_TCP, TCP_NODELAY, static_cast<int>(1));
 
-                            auto Error = SSL.GetError(Result);
+                auto Callback = Builder(Client, Info);
 
-                            if (Error == SSL_ERROR_WANT_WRITE)
-                            {
-                                Context.ListenFor(ePoll::Out | ePoll::In);
-                            }
-                            else if (Error == SSL_ERROR_WANT_READ)
-                            {
-                                Context.ListenFor(ePoll::In);
-                            }
-                            else
-                            {
-                                Context.Remove();
-                            }
-                        },
-                        [this]
-                        {
-                            static_cast<T &>(*this).DecrementConnectionCount();
-                        },
-                        Settings.Timeout);
+                Batch.Add(
+                    static_cast<T &>(*this).LoopFor(Context.Loop),
+                    std::move(Client),
+                    std::move(Callback),
+                    [this]
+                    {
+                        static_cast<T &>(*this).DecrementConnectionCount();
+                    });
+            }
 
-                    Counter = static_cast<T &>(*this).ThreadPool().Length() ? (Counter + 1) % static_cast<T &>(*this).ThreadPool().Length() : 0;
-                },
-                nullptr);
+            Batch.Commit(Settings.Timeout, Events);
         }
 
-    private:
         Connection::Settings Settings{
             1024 * 1024 * 1,
             1024 * 1024 * 5,
             1024,
-            1024,
             nullptr,
             [this](Connection::Context &Context, Network::HTTP::Request &Request)
             {
-                _Router.Match(Request.Path, Request.Method, Context, Request);
+                _Router.Match(Settings.ZeroCopy ? Request.PathView : std::string_view{Request.Path}, Request.Method, Context, Request);
             },
             false,
             false,
-            {5, 0}};
+            {5, 0},
+            false,
+            false};
 
         ::Router<void(HTTP::Connection::Context &, HTTP::Request &)> _Router;
 
@@ -1,6 +1,11 @@
 #pragma once
 
 #include <string>
+#include <charconv>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <algorithm>
 #include <Machine.hpp>
 #include <Format/Stream.hpp>
 #include <Format/Hex.hpp>
@@ -19,7 +24,11 @@ namespace Core::Network::HTTP
         Iterable::Queue<char> &Queue;
         bool RawContent = false;
 
-        Parser(size_t headerLimit, size_t contentLimit, size_t SendBufferSize, Iterable::Queue<char> &queue, bool rawContent = false) : Machine(), HeaderLimit(headerLimit), ContentLimit(contentLimit), RequestBufferSize(SendBufferSize), Queue(queue), RawContent(rawContent)
+        // Fills the message's views into Queue instead of copying path, headers and content
+
+        bool ZeroCopy = false;
+
+        Parser(size_t headerLimit, size_t contentLimit, size_t SendBufferSize, Iterable::Queue<char> &queue, bool rawContent = false, bool zeroCopy = false) : Machine(), HeaderLimit(headerLimit), ContentLimit(contentLimit), RequestBufferSize(SendBufferSize), Queue(queue), RawContent(rawContent), ZeroCopy(zeroCopy)
         {
             Queue = Iterable::Queue<char>(SendBufferSize);
         }
@@ -36,8 +45,16 @@ namespace Core::Network::HTTP
         size_t ChunkStart = 0;
         size_t ChunkStartTmp = 0;
 
+        // Where the message ends in Queue, pipelined requests follow it
+
+        size_t MessageEnd = 0;
+
         TMessage Result;
-        std::unordered_map<std::string, std::string>::iterator Iterator;
+        std::optional<std::string_view> Field;
+
+        // Address Queue's data started at when the views were taken
+
+        uintptr_t Origin = 0;
 
         bool RequiresContinue100 = false;
 
@@ -46,10 +63,18 @@ namespace Core::Network::HTTP
             // Crop buffer's content
 
             Machine::Reset();
-            Queue.Free(bodyPos + ContentLength);
-            Queue.Resize(Queue.Length() + RequestBufferSize);
+            Queue.Free(MessageEnd);
+
+            // Gives back the storage a large message grew, otherwise the pipelined
+            // rest stays where it is instead of being moved per request
+
+            size_t Wanted = Queue.Length() + RequestBufferSize;
+
+            if (Queue.Capacity() > 2 * Wanted)
+                Queue.Resize(Wanted);
 
             ContentLength = 0;
+            MessageEnd = 0;
             lenPos = 0;
 
             bodyPos = 0;
@@ -59,19 +84,40 @@ namespace Core::Network::HTTP
 
             {
                 Result.Headers.clear();
+                Result.Content.clear();
+                Result.Fields.Clear();
+                Result.Index.Clear();
+                Result.PathView = {};
+                Result.ContentView = {};
             }
 
-            Iterator = Result.Headers.end();
+            Field.reset();
             RequiresContinue100 = false;
         }
 
+        /**
+         * @brief Points the views at the buffer's current storage since
+         * reading the content may have grown and moved it
+         */
+        void Rebase(char const *Base)
+        {
+            uintptr_t From = std::exchange(Origin, reinterpret_cast<uintptr_t>(Base));
+
+            if (!ZeroCopy || From == Origin)
+                return;
+
+            Result.Fields.Rebase(From, Base);
+            Result.Index.Rebase(From, Base);
+            Result.PathView = HeaderViews::Move(Result.PathView, From, Base);
+        }
+
         // @todo Make this asynchronous
 
         void Continue100()
         {
-            auto ExpectIterator = Result.Headers.find("expect");
+            auto Expect = Result.Header(HeaderId::Expect);
 
-            if (ExpectIterator != Result.Headers.end() && ExpectIterator->second == "100-continue")
+            if (Expect && KnownHeaders::Equals(*Expect, "100-continue"))
             {
                 RequiresContinue100 = true;
             }
@@ -84,6 +130,12 @@ namespace Core::Network::HTTP
 
         void operator()() override
         {
+            // Reads after a pipelined request may have wrapped around the end,
+            // the message has to be contiguous so it's moved to the front once
+
+            if (Queue.IsWrapped())
+                Queue.Resize(Queue.Capacity());
+
             auto [Pointer, Size] = Queue.DataChunk();
 
             std::string_view Message{Pointer, Size};
@@ -94,23 +146,29 @@ namespace Core::Network::HTTP
 
             while (bodyPos == 0)
             {
-                // @todo Optimize the no limitation case
+                // Only the header block counts against the limit, the buffer may
+                // hold the requests pipelined behind this one too
 
-                if (HeaderLimit && Message.length() > HeaderLimit)
-                {
-                    throw HTTP::Status::RequestEntityTooLarge;
-                }
-
-                bodyPosTmp = Message.find("\r\n\r\n", bodyPosTmp);
+                bodyPosTmp = Scanner::Terminator(Message, bodyPosTmp);
 
                 if (bodyPosTmp != std::string::npos)
                 {
                     bodyPos = bodyPosTmp + 4;
 
+                    if (HeaderLimit && bodyPos > HeaderLimit)
+                    {
+                        throw HTTP::Status::RequestEntityTooLarge;
+                    }
+
                     break;
                 }
 
-                bodyPosTmp = Message.length() - 3;
+                if (HeaderLimit && Message.length() > HeaderLimit)
+                {
+                    throw HTTP::Status::RequestEntityTooLarge;
+                }
+
+                bodyPosTmp = Message.length() > 3 ? Message.length() - 3 : 0;
 
                 CO_YIELD();
             }
@@ -124,7 +182,7 @@ namespace Core::Network::HTTP
 
                 try
                 {
-                    TempIndex = Result.ParseFirstLine(Message);
+                    TempIndex = Result.ParseFirstLine(Message, ZeroCopy);
                 }
                 catch (...)
                 {
@@ -133,29 +191,45 @@ namespace Core::Network::HTTP
 
                 // Check for version
 
-                if (Result.Version[0] != '1' || (Result.Version[2] != '0' && Result.Version[2] != '1'))
+                if (Result.Version.length() != 3 || Result.Version[0] != '1' || (Result.Version[2] != '0' && Result.Version[2] != '1'))
                 {
                     throw HTTP::Status::HTTPVersionNotSupported;
                 }
 
-                Result.ParseHeaders(Message, TempIndex, bodyPos);
+                try
+                {
+                    if (ZeroCopy)
+                    {
+                        Result.ParseHeaderViews(Message, TempIndex, bodyPos);
+                        Origin = reinterpret_cast<uintptr_t>(Message.data());
+                    }
+                    else
+                    {
+                        Result.ParseHeaders(Message, TempIndex, bodyPos);
+                    }
+                }
+                catch (...)
+                {
+                    throw HTTP::Status::BadRequest;
+                }
             }
 
             // Check for content length
 
-            Iterator = Result.Headers.find("content-length");
+            Field = Result.Header(HeaderId::ContentLength);
 
-            if (Iterator != Result.Headers.end() && !Iterator->second.empty())
+            if (Field && !Field->empty())
             {
-                // Get the length of content
+                // Get the length of content, only digits and all of them
 
-                try
-                {
-                    ContentLength = std::stoull(Iterator->second);
-                }
-                catch (...)
                 {
-                    throw HTTP::Status::BadRequest;
+                    auto End = Field->data() + Field->length();
+                    auto [Last, Error] = std::from_chars(Field->data(), End, ContentLength);
+
+                    if (Error != std::errc{} || Last != End)
+                    {
+                        throw HTTP::Status::BadRequest;
+                    }
                 }
 
                 // Check if the length is in valid range
@@ -178,18 +252,27 @@ namespace Core::Network::HTTP
 
                 // fill the content
 
-                Result.Content = Message.substr(bodyPos, ContentLength);
+                if (ZeroCopy)
+                    Result.ContentView = Message.substr(bodyPos, ContentLength);
+                else
+                    Result.Content = Message.substr(bodyPos, ContentLength);
+
+                MessageEnd = bodyPos + ContentLength;
             }
 
             // Check for content encoding
 
-            else if ((Iterator = Result.Headers.find("transfer-encoding")) == Result.Headers.end())
+            else if (!(Field = Result.Header(HeaderId::TransferEncoding)))
             {
                 Continue100();
 
+                MessageEnd = bodyPos;
+
+                Rebase(Message.data());
+
                 CO_TERMINATE();
             }
-            else if (Iterator->second == "chunked")
+            else if (KnownHeaders::Contains(*Field, "chunked"))
             {
                 Continue100();
 
@@ -215,7 +298,9 @@ namespace Core::Network::HTTP
 
                     ChunkStart = (ChunkStartTmp + 2);
 
-                    while (Message.length() - ChunkStart < ChunkLength)
+                    // Waits for the CRLF after the data too
+
+                    while (Message.length() - ChunkStart < ChunkLength + 2)
                     {
                         CO_YIELD();
                     }
@@ -233,18 +318,37 @@ namespace Core::Network::HTTP
 
                 } while (ChunkLength);
 
-                if (RawContent)
+                MessageEnd = ChunkStart;
+
+                if (RawContent && ZeroCopy)
+                {
+                    Result.ContentView = Message.substr(bodyPos, ChunkStart - bodyPos);
+                }
+                else if (RawContent)
                 {
                     Result.Content = Message.substr(bodyPos, ChunkStart - bodyPos);
                 }
                 else
                 {
+                    // Decoded chunks aren't contiguous in the buffer so views get the copy
+
                     Result.Content = std::string{ContentBuffer.Content(), ContentBuffer.Length()};
-                    Result.Headers.erase(Iterator);
                     ContentBuffer.Free();
+
+                    if (ZeroCopy)
+                    {
+                        Result.ContentView = Result.Content;
+                        Result.Fields.Remove("transfer-encoding");
+                    }
+                    else
+                    {
+                        Result.Headers.erase("transfer-encoding");
+                    }
+
+                    Result.Index.Unset(HeaderId::TransferEncoding);
                 }
             }
-            else if (Iterator->second == "gzip")
+            else if (KnownHeaders::Contains(*Field, "gzip"))
             {
                 // Read the body chinks till the end
 
@@ -260,6 +364,8 @@ namespace Core::Network::HTTP
                 throw HTTP::Status::NotImplemented;
             }
 
+            Rebase(Message.data());
+
             CO_TERMINATE();
 
             CO_END;
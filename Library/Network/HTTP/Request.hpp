@@ -36,6 +36,21 @@ namespace Core
                 Methods Method;
                 std::string Path;
 
+                // Set instead of Path by parsers in zero-copy mode
+
+                std::string_view PathView;
+
+                /**
+                 * @brief Copies the views into Path, Headers and Content
+                 */
+                void Materialize()
+                {
+                    Message::Materialize();
+
+                    if (PathView.data())
+                        Path = PathView;
+                }
+
                 friend Format::Stream &operator<<(Format::Stream &Ser, Request const &R)
                 {
                     Ser << MethodStrings[size_t(R.Method)] << ' ' << R.Path << " HTTP/" << R.Version << "\r\n";
@@ -167,7 +182,10 @@ namespace Core
                 //     return Result;
                 // }
 
-                size_t ParseFirstLine(std::string_view Text)
+                /**
+                 * @param View Points PathView into Text instead of copying Path
+                 */
+                size_t ParseFirstLine(std::string_view Text, bool View = false)
                 {
                     // @todo Handle null case
 
@@ -176,7 +194,7 @@ namespace Core
 
                     // Parse method
 
-                    if ((CursorTmp = Text.find(' ', Cursor)) == std::string::npos)
+                    if ((CursorTmp = Scanner::TokenEnd(Text, Cursor)) == std::string::npos || CursorTmp == Cursor || Text[CursorTmp] != ' ')
                     {
                         throw std::invalid_argument("Invalid method");
                     }
@@ -188,19 +206,28 @@ namespace Core
 
                     // Parse path
 
-                    if ((CursorTmp = Text.find(' ', Cursor)) == std::string::npos)
+                    if ((CursorTmp = Scanner::TargetEnd(Text, Cursor)) == std::string::npos || CursorTmp == Cursor || Text[CursorTmp] != ' ')
                     {
                         throw std::invalid_argument("Invalid path");
                     }
 
-                    Path = Text.substr(Cursor, CursorTmp - Cursor);
+                    if (View)
+                        PathView = Text.substr(Cursor, CursorTmp - Cursor);
+                    else
+                        Path = Text.substr(Cursor, CursorTmp - Cursor);
+
+                    if (Text.substr(CursorTmp + 1, 5) != "HTTP/")
+                    {
+                        throw std::invalid_argument("Invalid version");
+                    }
+
                     Cursor = CursorTmp + 6;
 
                     // Parse version
 
                     // @todo Maybe check the version's length?
 
-                    if ((CursorTmp = Text.find('\r', Cursor)) == std::string::npos)
+                    if ((CursorTmp = Scanner::ValueEnd(Text, Cursor)) == std::string::npos || Text[CursorTmp] != '\r')
                     {
                         throw std::invalid_argument("Invalid version");
                     }
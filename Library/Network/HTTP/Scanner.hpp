@@ -0,0 +1,324 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define COREKIT_SCANNER_X86
+#endif
+
+namespace Core::Network::HTTP
+{
+    /**
+     * @brief Byte scanning behind the HTTP/1.x parser, after picohttpparser
+     * Boundaries are searched 32 bytes at a time with AVX2 or 16 with SSE4.2
+     * range compares, picked once at startup from cpuid, with a scalar
+     * fallback. Header names are short so their tokens are checked with a
+     * table instead. Every search returns npos when nothing matches.
+     */
+    class Scanner
+    {
+    public:
+        enum class Levels
+        {
+            Scalar,
+            SSE42,
+            AVX2,
+        };
+
+        static constexpr size_t npos = std::string_view::npos;
+
+        static inline Levels Level()
+        {
+            return Selected;
+        }
+
+        /**
+         * @brief Start of the first "\r\n\r\n" at or after From
+         */
+        static inline size_t Terminator(std::string_view Text, size_t From = 0)
+        {
+            if (From >= Text.length())
+                return npos;
+
+            return Selected == Levels::AVX2 ? TerminatorAVX2(Text, From) : Selected == Levels::SSE42 ? TerminatorSSE2(Text, From) : TerminatorScalar(Text, From);
+        }
+
+        /**
+         * @brief First control character other than HTAB at or after From,
+         * which ends a header value or the request line
+         */
+        static inline size_t ValueEnd(std::string_view Text, size_t From = 0)
+        {
+            if (From >= Text.length())
+                return npos;
+
+            return Selected == Levels::AVX2 ? ValueEndAVX2(Text, From) : Selected == Levels::SSE42 ? ValueEndSSE42(Text, From) : ValueEndScalar(Text, From);
+        }
+
+        /**
+         * @brief First space, control or DEL character at or after From,
+         * which ends a request target
+         */
+        static inline size_t TargetEnd(std::string_view Text, size_t From = 0)
+        {
+            if (From >= Text.length())
+                return npos;
+
+            return Selected == Levels::AVX2 ? TargetEndAVX2(Text, From) : Selected == Levels::SSE42 ? TargetEndSSE42(Text, From) : TargetEndScalar(Text, From);
+        }
+
+        /**
+         * @brief First byte at or after From that isn't an RFC 9110 tchar,
+         * which ends a method or a header name
+         */
+        static inline size_t TokenEnd(std::string_view Text, size_t From = 0)
+        {
+            for (size_t i = From; i < Text.length(); i++)
+            {
+                if (!Tokens[static_cast<unsigned char>(Text[i])])
+                    return i;
+            }
+
+            return npos;
+        }
+
+        static inline bool IsToken(char Character)
+        {
+            return Tokens[static_cast<unsigned char>(Character)];
+        }
+
+    private:
+        static constexpr std::array<bool, 256> Tokens = []
+        {
+            std::array<bool, 256> Result{};
+
+            for (int c = '0'; c <= '9'; c++)
+                Result[c] = true;
+
+            for (int c = 'a'; c <= 'z'; c++)
+                Result[c] = Result[c - 'a' + 'A'] = true;
+
+            for (unsigned char c : std::string_view("!#$%&'*+-.^_`|~"))
+                Result[c] = true;
+
+            return Result;
+        }();
+
+        static inline bool IsValueEnd(unsigned char Character)
+        {
+            return (Character < 0x20 && Character != '\t') || Character == 0x7F;
+        }
+
+        static inline bool IsTargetEnd(unsigned char Character)
+        {
+            return Character <= 0x20 || Character == 0x7F;
+        }
+
+        static size_t TerminatorScalar(std::string_view Text, size_t From)
+        {
+            return Text.find("\r\n\r\n", From);
+        }
+
+        static size_t ValueEndScalar(std::string_view Text, size_t From)
+        {
+            for (size_t i = From; i < Text.length(); i++)
+            {
+                if (IsValueEnd(Text[i]))
+                    return i;
+            }
+
+            return npos;
+        }
+
+        static size_t TargetEndScalar(std::string_view Text, size_t From)
+        {
+            for (size_t i = From; i < Text.length(); i++)
+            {
+                if (IsTargetEnd(Text[i]))
+                    return i;
+            }
+
+            return npos;
+        }
+
+#ifdef COREKIT_SCANNER_X86
+        static Levels Detect()
+        {
+            __builtin_cpu_init();
+
+            if (__builtin_cpu_supports("avx2"))
+                return Levels::AVX2;
+
+            if (__builtin_cpu_supports("sse4.2"))
+                return Levels::SSE42;
+
+            return Levels::Scalar;
+        }
+
+        // The terminator is matched as four shifted byte compares so a
+        // block's mask only holds real matches, the last 3 bytes go scalar
+
+        __attribute__((target("avx2"))) static size_t TerminatorAVX2(std::string_view Text, size_t From)
+        {
+            char const *Data = Text.data();
+            size_t Length = Text.length();
+            size_t i = From;
+
+            __m256i const CR = _mm256_set1_epi8('\r');
+            __m256i const LF = _mm256_set1_epi8('\n');
+
+            for (; i + 32 + 3 <= Length; i += 32)
+            {
+                __m256i First = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(Data + i)), CR);
+                __m256i Second = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(Data + i + 1)), LF);
+                __m256i Third = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(Data + i + 2)), CR);
+                __m256i Fourth = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(Data + i + 3)), LF);
+
+                uint32_t Mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_and_si256(First, Second), _mm256_and_si256(Third, Fourth))));
+
+                if (Mask)
+                    return i + __builtin_ctz(Mask);
+            }
+
+            return TerminatorScalar(Text, i);
+        }
+
+        static size_t TerminatorSSE2(std::string_view Text, size_t From)
+        {
+            char const *Data = Text.data();
+            size_t Length = Text.length();
+            size_t i = From;
+
+            __m128i const CR = _mm_set1_epi8('\r');
+            __m128i const LF = _mm_set1_epi8('\n');
+
+            for (; i + 16 + 3 <= Length; i += 16)
+            {
+                __m128i First = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const *>(Data + i)), CR);
+                __m128i Second = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const *>(Data + i + 1)), LF);
+                __m128i Third = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const *>(Data + i + 2)), CR);
+                __m128i Fourth = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const *>(Data + i + 3)), LF);
+
+                uint32_t Mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(_mm_and_si128(First, Second), _mm_and_si128(Third, Fourth))));
+
+                if (Mask)
+                    return i + __builtin_ctz(Mask);
+            }
+
+            return TerminatorScalar(Text, i);
+        }
+
+        __attribute__((target("avx2"))) static size_t ValueEndAVX2(std::string_view Text, size_t From)
+        {
+            char const *Data = Text.data();
+            size_t Length = Text.length();
+            size_t i = From;
+
+            __m256i const Control = _mm256_set1_epi8(0x1F);
+            __m256i const Tab = _mm256_set1_epi8('\t');
+            __m256i const Delete = _mm256_set1_epi8(0x7F);
+
+            for (; i + 32 <= Length; i += 32)
+            {
+                __m256i Block = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(Data + i));
+
+                // Unsigned Block <= 0x1F is min(Block, 0x1F) == Block
+
+                __m256i Low = _mm256_cmpeq_epi8(_mm256_min_epu8(Block, Control), Block);
+                __m256i Hit = _mm256_or_si256(_mm256_andnot_si256(_mm256_cmpeq_epi8(Block, Tab), Low), _mm256_cmpeq_epi8(Block, Delete));
+
+                uint32_t Mask = static_cast<uint32_t>(_mm256_movemask_epi8(Hit));
+
+                if (Mask)
+                    return i + __builtin_ctz(Mask);
+            }
+
+            return ValueEndScalar(Text, i);
+        }
+
+        __attribute__((target("sse4.2"))) static size_t ValueEndSSE42(std::string_view Text, size_t From)
+        {
+            static char const Ranges[16] = "\x00\x08\x0a\x1f\x7f\x7f";
+
+            char const *Data = Text.data();
+            size_t Length = Text.length();
+            size_t i = From;
+
+            __m128i const Set = _mm_loadu_si128(reinterpret_cast<__m128i const *>(Ranges));
+
+            for (; i + 16 <= Length; i += 16)
+            {
+                int Index = _mm_cmpestri(Set, 6, _mm_loadu_si128(reinterpret_cast<__m128i const *>(Data + i)), 16, _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES | _SIDD_LEAST_SIGNIFICANT);
+
+                if (Index != 16)
+                    return i + Index;
+            }
+
+            return ValueEndScalar(Text, i);
+        }
+
+        __attribute__((target("avx2"))) static size_t TargetEndAVX2(std::string_view Text, size_t From)
+        {
+            char const *Data = Text.data();
+            size_t Length = Text.length();
+            size_t i = From;
+
+            __m256i const Space = _mm256_set1_epi8(0x20);
+            __m256i const Delete = _mm256_set1_epi8(0x7F);
+
+            for (; i + 32 <= Length; i += 32)
+            {
+                __m256i Block = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(Data + i));
+                __m256i Hit = _mm256_or_si256(_mm256_cmpeq_epi8(_mm256_min_epu8(Block, Space), Block), _mm256_cmpeq_epi8(Block, Delete));
+
+                uint32_t Mask = static_cast<uint32_t>(_mm256_movemask_epi8(Hit));
+
+                if (Mask)
+                    return i + __builtin_ctz(Mask);
+            }
+
+            return TargetEndScalar(Text, i);
+        }
+
+        __attribute__((target("sse4.2"))) static size_t TargetEndSSE42(std::string_view Text, size_t From)
+        {
+            static char const Ranges[16] = "\x00\x20\x7f\x7f";
+
+            char const *Data = Text.data();
+            size_t Length = Text.length();
+            size_t i = From;
+
+            __m128i const Set = _mm_loadu_si128(reinterpret_cast<__m128i const *>(Ranges));
+
+            for (; i + 16 <= Length; i += 16)
+            {
+                int Index = _mm_cmpestri(Set, 4, _mm_loadu_si128(reinterpret_cast<__m128i const *>(Data + i)), 16, _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES | _SIDD_LEAST_SIGNIFICANT);
+
+                if (Index != 16)
+                    return i + Index;
+            }
+
+            return TargetEndScalar(Text, i);
+        }
+#else
+        static Levels Detect()
+        {
+            return Levels::Scalar;
+        }
+
+        static size_t TerminatorAVX2(std::string_view Text, size_t From) { return TerminatorScalar(Text, From); }
+        static size_t TerminatorSSE2(std::string_view Text, size_t From) { return TerminatorScalar(Text, From); }
+        static size_t ValueEndAVX2(std::string_view Text, size_t From) { return ValueEndScalar(Text, From); }
+        static size_t ValueEndSSE42(std::string_view Text, size_t From) { return ValueEndScalar(Text, From); }
+        static size_t TargetEndAVX2(std::string_view Text, size_t From) { return TargetEndScalar(Text, From); }
+        static size_t TargetEndSSE42(std::string_view Text, size_t From) { return TargetEndScalar(Text, From); }
+#endif
+
+        static inline Levels const Selected = Detect();
+    };
+}
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <array>
+#include <algorithm>
+#include <ctime>
+#include <string>
+#include <charconv>
+#include <string_view>
+
+#include <Iterable/Queue.hpp>
+#include <Network/HTTP/HTTP.hpp>
+#include <Network/HTTP/Response.hpp>
+
+namespace Core::Network::HTTP
+{
+    /**
+     * @brief Writes responses into an output buffer allocated once at their
+     * exact size. Standard status lines are rendered once per version and
+     * the Date header once per wall-clock second on each thread.
+     */
+    class Serializer
+    {
+    public:
+        /**
+         * @brief Interned "HTTP/<Version> <Code> <Brief>\r\n", empty unless
+         * the version is 1.0 or 1.1 and the brief is the standard one
+         */
+        static std::string_view StatusLine(std::string_view Version, HTTP::Status Status, std::string_view Brief)
+        {
+            static Table const Lines = Build();
+
+            size_t Code = static_cast<size_t>(Status);
+
+            if (Code < MinCode || Code >= MaxCode || Version.length() != 3 || Version[0] != '1' || Version[1] != '.' || (Version[2] != '0' && Version[2] != '1'))
+                return {};
+
+            std::string_view Line = Lines[Version[2] - '0'][Code - MinCode];
+
+            // "HTTP/1.1 200 " takes 13 characters
+
+            if (Line.empty() || Line.substr(13, Line.length() - 15) != Brief)
+                return {};
+
+            return Line;
+        }
+
+        /**
+         * @brief "date: <IMF-fixdate>\r\n" cached per thread and rendered
+         * again once the given wall-clock second differs from the cached one
+         * @param Now Seconds since the epoch
+         */
+        static std::string_view DateLine(time_t Now)
+        {
+            static thread_local Cache Date;
+
+            if (Now != Date.Second)
+            {
+                Date.Second = Now;
+                Date.Length = Render(Date.Line, Now);
+            }
+
+            return {Date.Line, Date.Length};
+        }
+
+        /**
+         * @brief Serializes the head of the response and its content
+         * @param Extra Lines added after the headers, e.g. the connection header
+         * @param BodyLength Length to announce if no content-length header is set,
+         * which may include a file sent after the buffer
+         * @param Now Wall-clock seconds for the date header
+         */
+        static Iterable::Queue<char> Serialize(HTTP::Response const &Response, std::string_view Extra, size_t BodyLength, time_t Now = time(nullptr))
+        {
+            constexpr std::string_view LengthName = "content-length: ";
+            constexpr std::string_view CookieName = "set-cookie: ";
+
+            std::string_view Status = StatusLine(Response.Version, Response.Status, Response.Brief);
+            std::string_view Date;
+
+            char Code[8];
+            char *CodeEnd = std::to_chars(Code, Code + sizeof Code, static_cast<unsigned short>(Response.Status)).ptr;
+
+            char Length[24];
+            char *LengthEnd = Length;
+
+            bool HasLength = false;
+            bool HasDate = false;
+
+            // Measure
+
+            size_t Size = Status.empty() ? 5 + Response.Version.length() + 1 + (CodeEnd - Code) + 1 + Response.Brief.length() + 2 : Status.length();
+
+            for (auto const &[k, v] : Response.Headers)
+            {
+                auto Id = KnownHeaders::Find(k);
+
+                HasLength |= Id == HeaderId::ContentLength;
+                HasDate |= Id == HeaderId::Date;
+
+                Size += k.length() + 2 + v.length() + 2;
+            }
+
+            Size += Extra.length();
+
+            if (!HasLength)
+            {
+                LengthEnd = std::to_chars(Length, Length + sizeof Length, BodyLength).ptr;
+                Size += LengthName.length() + (LengthEnd - Length) + 2;
+            }
+
+            if (!HasDate)
+            {
+                Date = DateLine(Now);
+                Size += Date.length();
+            }
+
+            Response.SetCookies.ForEach(
+                [&](std::string const &Cookie)
+                {
+                    Size += CookieName.length() + Cookie.length() + 2;
+                });
+
+            Size += 2 + Response.Content.length();
+
+            // Write
+
+            Iterable::Queue<char> Buffer(Size);
+            char *Cursor = Buffer.Content();
+
+            auto Put = [&Cursor](std::string_view Text)
+            {
+                Cursor = std::copy(Text.begin(), Text.end(), Cursor);
+            };
+
+            if (Status.empty())
+            {
+                Put("HTTP/");
+                Put(Response.Version);
+                Put(" ");
+                Put({Code, static_cast<size_t>(CodeEnd - Code)});
+                Put(" ");
+                Put(Response.Brief);
+                Put("\r\n");
+            }
+            else
+            {
+                Put(Status);
+            }
+
+            for (auto const &[k, v] : Response.Headers)
+            {
+                Put(k);
+                Put(": ");
+                Put(v);
+                Put("\r\n");
+            }
+
+            Put(Extra);
+
+            if (!HasLength)
+            {
+                Put(LengthName);
+                Put({Length, static_cast<size_t>(LengthEnd - Length)});
+                Put("\r\n");
+            }
+
+            Put(Date);
+
+            Response.SetCookies.ForEach(
+                [&](std::string const &Cookie)
+                {
+                    Put(CookieName);
+                    Put(Cookie);
+                    Put("\r\n");
+                });
+
+            Put("\r\n");
+            Put(Response.Content);
+
+            Buffer.AdvanceTail(Size);
+
+            return Buffer;
+        }
+
+    private:
+        static constexpr size_t MinCode = 100;
+        static constexpr size_t MaxCode = 600;
+
+        // Status lines of HTTP/1.0 and HTTP/1.1 indexed by code
+
+        using Table = std::array<std::array<std::string, MaxCode - MinCode>, 2>;
+
+        struct Cache
+        {
+            time_t Second = -1;
+            size_t Length = 0;
+            char Line[48];
+        };
+
+        static Table Build()
+        {
+            Table Result;
+
+            for (auto const &[Status, Brief] : StatusMessage)
+            {
+                auto Code = std::to_string(static_cast<unsigned short>(Status));
+
+                Result[0][static_cast<size_t>(Status) - MinCode] = "HTTP/1.0 " + Code + ' ' + Brief + "\r\n";
+                Result[1][static_cast<size_t>(Status) - MinCode] = "HTTP/1.1 " + Code + ' ' + Brief + "\r\n";
+            }
+
+            return Result;
+        }
+
+        static inline void Digits(char *Output, int Value)
+        {
+            Output[0] = '0' + Value / 10;
+            Output[1] = '0' + Value % 10;
+        }
+
+        /**
+         * @brief Writes the date line in the RFC 9110 IMF-fixdate format without
+         * going through strftime, whose names follow the locale
+         * @return Length of the line
+         */
+        static size_t Render(char *Output, time_t Now)
+        {
+            static constexpr char const Days[] = "SunMonTueWedThuFriSat";
+            static constexpr char const Months[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+
+            struct tm State;
+
+            gmtime_r(&Now, &State);
+
+            // date: Sun, 06 Nov 1994 08:49:37 GMT\r\n
+
+            std::string_view Line = "date: Sun, 06 Nov 1994 08:49:37 GMT\r\n";
+
+            Line.copy(Output, Line.length());
+
+            std::string_view(Days + State.tm_wday * 3, 3).copy(Output + 6, 3);
+            Digits(Output + 11, State.tm_mday);
+            std::string_view(Months + State.tm_mon * 3, 3).copy(Output + 14, 3);
+            Digits(Output + 18, (State.tm_year + 1900) / 100);
+            Digits(Output + 20, (State.tm_year + 1900) % 100);
+            Digits(Output + 23, State.tm_hour);
+            Digits(Output + 26, State.tm_min);
+            Digits(Output + 29, State.tm_sec);
+
+            return Line.length();
+        }
+    };
+}
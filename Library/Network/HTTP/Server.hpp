@@ -2,8 +2,10 @@
 
 #include <string>
 #include <optional>
+#include <stdexcept>
 #include <signal.h>
 #include <netinet/tcp.h>
+#include <linux/filter.h>
 
 #include <Duration.hpp>
 #include <Network/Socket.hpp>
@@ -17,6 +19,20 @@
 
 namespace Core::Network::HTTP
 {
+    /**
+     * @brief How the kernel picks among per-loop listeners
+     * None : Kernel's default hash of the connection
+     * IncomingCPU : Prefer the listener of the loop pinned to the receiving CPU
+     * BPF : Classic BPF program selecting the listener of the loop pinned to the receiving CPU
+     * Steering needs every loop pinned to a single CPU
+     */
+    enum class Steering
+    {
+        None,
+        IncomingCPU,
+        BPF,
+    };
+
     template <template <typename> typename... TModules>
     class Server : public Async::Runnable, public TModules<Server<TModules...>>...
     {
@@ -65,27 +81,98 @@ namespace Core::Network::HTTP
             Pool.Stop();
         }
 
+        /**
+         * @brief Gives every loop its own SO_REUSEPORT listener on each
+         * endpoint so connections are accepted on the loop that serves them.
+         * Must be set before listening, steering also needs Pin set before listening.
+         */
+        inline auto &ReusePort(Steering Mode = Steering::None)
+        {
+            PerLoop = true;
+            _Steering = Mode;
+            return *this;
+        }
+
+        /**
+         * @brief Loop that should serve a connection accepted on the given loop
+         */
+        inline Async::EventLoop &LoopFor(Async::EventLoop &Acceptor)
+        {
+            return PerLoop ? Acceptor : Pool.Next();
+        }
+
         template <typename TCallback, typename TEndCallback>
         inline auto &ListenWith(Network::EndPoint const &endPoint, TCallback &&Callback, TEndCallback &&EndCallback)
         {
-            Network::Socket Router(static_cast<Network::Socket::SocketFamily>(endPoint.Address().Family()), Network::Socket::TCP);
+            if (PerLoop)
+            {
+                size_t Count = Pool.Length();
+                Iterable::List<Network::Socket> Routers(Count);
+                Iterable::List<int> CPUs(Count);
 
-            // Set Reuse
+                // Steering maps receiving CPUs to loops, which only holds for pinned loops
 
-            Router.SetOptions(SOL_SOCKET, SO_REUSEADDR, static_cast<int>(1));
-            Router.SetOptions(SOL_SOCKET, SO_REUSEPORT, static_cast<int>(1));
+                for (size_t i = 0; i < Count && _Steering != Steering::None; i++)
+                {
+                    CPUs.Add(Pool.PinnedCPU(i));
 
-            // Bind socket
+                    if (CPUs[i] < 0)
+                        throw std::runtime_error("Steering requires every loop pinned to one CPU");
+                }
 
-            Router.Bind(endPoint);
+                // Sockets join the reuseport group in listen order, matching loop indices
+
+                for (size_t i = 0; i < Count; i++)
+                {
+                    Routers.Add(Bind(endPoint));
+
+                    if (_Steering == Steering::IncomingCPU)
+                        Routers[i].SetOptions(SOL_SOCKET, SO_INCOMING_CPU, CPUs[i]);
+
+                    Routers[i].Listen();
+                }
+
+                if (_Steering == Steering::BPF)
+                {
+                    Iterable::List<sock_filter> Code(Count * 2 + 3);
+
+                    // Returns the index of the loop pinned to the receiving CPU, CPU % Loops for other CPUs
+
+                    Code.Add(sock_filter{BPF_LD | BPF_W | BPF_ABS, 0, 0, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU)});
+
+                    for (size_t i = 0; i < Count; i++)
+                    {
+                        Code.Add(sock_filter{BPF_JMP | BPF_JEQ | BPF_K, 0, 1, static_cast<uint32_t>(CPUs[i])});
+                        Code.Add(sock_filter{BPF_RET | BPF_K, 0, 0, static_cast<uint32_t>(i)});
+                    }
+
+                    Code.Add(sock_filter{BPF_ALU | BPF_MOD | BPF_K, 0, 0, static_cast<uint32_t>(Count)});
+                    Code.Add(sock_filter{BPF_RET | BPF_A, 0, 0, 0});
+
+                    sock_fprog Program{static_cast<unsigned short>(Code.Length()), Code.Content()};
+
+                    Routers[0].SetOptions(SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &Program, sizeof(Program));
+                }
+
+                for (size_t i = 0; i < Count; i++)
+                {
+                    Pool[i].AssignListener(
+                        std::move(Routers[i]),
+                        std::decay_t<TCallback>(Callback),
+                        std::decay_t<TEndCallback>(EndCallback));
+                }
+
+                return *this;
+            }
+
+            Network::Socket Router = Bind(endPoint);
 
             Router.Listen();
 
-            Pool[Turn].Assign(
+            Pool[Turn].AssignListener(
                 std::move(Router),
                 std::forward<TCallback>(Callback),
-                std::forward<TEndCallback>(EndCallback),
-                {0, 0});
+                std::forward<TEndCallback>(EndCallback));
 
             Turn = Pool.Length() ? (Turn + 1) % Pool.Length() : 0;
 
@@ -108,6 +195,70 @@ namespace Core::Network::HTTP
             ConnectionCount.fetch_sub(1, std::memory_order_relaxed);
         }
 
+        inline auto &Tickless(bool Value = true)
+        {
+            Pool.Tickless(Value);
+            return *this;
+        }
+
+        /**
+         * @brief Lets the first Count loops spin for Budget before sleeping
+         */
+        inline auto &Spin(Duration const &Budget, bool BusyPoll = false, size_t Count = static_cast<size_t>(-1))
+        {
+            Pool.Spin(Budget, BusyPoll, Count);
+            return *this;
+        }
+
+        inline auto &Pin(bool Value = true)
+        {
+            Pool.Pin(Value);
+            return *this;
+        }
+
+        inline auto &Pin(size_t Index, cpu_set_t const &CPUs)
+        {
+            Pool.Pin(Index, CPUs);
+            return *this;
+        }
+
+        inline auto &LocalMemory(bool Value = true)
+        {
+            Pool.LocalMemory(Value);
+            return *this;
+        }
+
+        /**
+         * @brief Dedicated executor for work offloaded from handlers
+         */
+        inline auto &Compute(size_t Count)
+        {
+            Pool.Compute(Count);
+            return *this;
+        }
+
+        /**
+         * @brief Reports handlers that keep a loop busy for longer than Budget
+         */
+        template <typename TCallback>
+        inline auto &Watch(Duration const &Budget, TCallback &&OnStall, int Signal = 0)
+        {
+            Pool.Watch(Budget, std::forward<TCallback>(OnStall), Signal);
+            return *this;
+        }
+
+        inline auto &MaxEvents(size_t Count)
+        {
+            Pool.MaxEvents(Count);
+            return *this;
+        }
+
+        inline auto &Dispatch(Async::ThreadPool::Policies Policy)
+        {
+            Pool.Dispatch(Policy);
+            return *this;
+        }
+
         inline auto &MaxConnections(size_t Count)
         {
             MaxConnectionCount = Count;
@@ -123,9 +274,31 @@ namespace Core::Network::HTTP
 #endif
 
     protected:
+        static Network::Socket Bind(Network::EndPoint const &endPoint)
+        {
+            Network::Socket Router(static_cast<Network::Socket::SocketFamily>(endPoint.Address().Family()), Network::Socket::TCP);
+
+            // Set Reuse
+
+            Router.SetOptions(SOL_SOCKET, SO_REUSEADDR, static_cast<int>(1));
+            Router.SetOptions(SOL_SOCKET, SO_REUSEPORT, static_cast<int>(1));
+
+            // Bind socket
+
+            Router.Bind(endPoint);
+
+            // Accepts are drained until EAGAIN so the listener must not block
+
+            Router.Blocking(false);
+
+            return Router;
+        }
+
         size_t MaxConnectionCount{1024};
         std::atomic<size_t> ConnectionCount{0};
         Async::ThreadPool Pool;
         volatile size_t Turn = 0;
+        bool PerLoop = false;
+        Steering _Steering = Steering::None;
     };
 }
\ No newline at end of file
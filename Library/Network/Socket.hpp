@@ -173,6 +173,36 @@ namespace Core::Network
             return {ClientDescriptor, (struct sockaddr *)&ClientAddress};
         }
 
+        /**
+         * @brief Accepts a pending connection without throwing on an empty queue
+         * @return An invalid socket once nothing is left to accept
+         */
+        std::tuple<Socket, EndPoint> TryAccept(int Flags = 0) const
+        {
+            struct sockaddr_storage ClientAddress;
+            socklen_t Size;
+            int ClientDescriptor;
+
+            do
+            {
+                Size = sizeof ClientAddress;
+                ClientDescriptor = accept4(_INode, (struct sockaddr *)&ClientAddress, &Size, Flags);
+
+                // Connections reset before being accepted are skipped
+
+            } while (ClientDescriptor < 0 && (errno == EINTR || errno == ECONNABORTED));
+
+            if (ClientDescriptor < 0)
+            {
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                    return {Socket(), EndPoint()};
+
+                throw std::system_error(errno, std::generic_category());
+            }
+
+            return {ClientDescriptor, (struct sockaddr *)&ClientAddress};
+        }
+
         Socket Accept(EndPoint &Peer, int Flags = 0) const
         {
             struct sockaddr_storage ClientAddress;
@@ -36,44 +36,50 @@ namespace Core
 
                 Server.Listen();
 
-                Pool[0].Assign(
+                // Accepts are drained until EAGAIN so the listener must not block
+
+                Server.Blocking(false);
+
+                Pool[0].AssignListener(
                     std::move(Server),
-                    [this, HandlerBuilder = std::forward<TCallback>(handlerBuilder), Counter = 0](Async::EventLoop::Context &Context, ePoll::Entry &) mutable
+                    [this, HandlerBuilder = std::forward<TCallback>(handlerBuilder)](Async::EventLoop::Context &Context, ePoll::Entry &) mutable
                     {
                         Network::Socket &Server = static_cast<Network::Socket&>(Context.Self.File);
 
-                        auto [Client, Info] = Server.Accept();
+                        Async::AssignBatch Batch;
 
-                        if (ConnectionCount.fetch_add(1, std::memory_order_relaxed) > Settings.MaxConnectionCount)
+                        for (size_t i = 0; i < Settings.AcceptBatch; i++)
                         {
-                            ConnectionCount.fetch_sub(1, std::memory_order_relaxed);
-                            return;
-                        }
+                            auto [Client, Info] = Server.TryAccept(SOCK_NONBLOCK | SOCK_CLOEXEC);
 
-                        // Set Non-blocking
+                            if (!Client)
+                                break;
 
-                        Client.Blocking(false);
+                            if (ConnectionCount.fetch_add(1, std::memory_order_relaxed) > Settings.MaxConnectionCount)
+                            {
+                                ConnectionCount.fetch_sub(1, std::memory_order_relaxed);
+                                continue;
+                            }
 
-                        // Set NoDelay
+                            // Set NoDelay
 
-                        if (Settings.NoDelay)
-                            Client.SetOptions(IPPROTO_TCP, TCP_NODELAY, static_cast<int>(1));
+                            if (Settings.NoDelay)
+                                Client.SetOptions(IPPROTO_TCP, TCP_NODELAY, static_cast<int>(1));
 
-                        auto &Turn = Pool[Counter];
+                            auto Handler = HandlerBuilder(Info, Settings.Timeout);
 
-                        Turn.Assign(
-                            std::move(Client),
-                            HandlerBuilder(Info, Settings.Timeout),
-                            [this]
-                            {
-                                ConnectionCount.fetch_sub(1, std::memory_order_relaxed);
-                            },
-                            Settings.Timeout);
+                            Batch.Add(
+                                Pool.Next(),
+                                std::move(Client),
+                                std::move(Handler),
+                                [this]
+                                {
+                                    ConnectionCount.fetch_sub(1, std::memory_order_relaxed);
+                                });
+                        }
 
-                        Counter = (Counter + 1) % Pool.Length();
-                    },
-                    nullptr,
-                    {0, 0});
+                        Batch.Commit(Settings.Timeout);
+                    });
             }
 
             TCPServer &operator=(TCPServer const &Other) = delete;
@@ -126,11 +132,62 @@ namespace Core
                 Settings.NoDelay = Enable;
             }
 
+            void AcceptBatch(size_t Count)
+            {
+                Settings.AcceptBatch = Count ? Count : 1;
+            }
+
             void IdleTimeout(Duration const &timeout)
             {
                 Settings.Timeout = timeout;
             }
 
+            void Tickless(bool Enable)
+            {
+                Pool.Tickless(Enable);
+            }
+
+            void Spin(Duration const &Budget, bool BusyPoll = false, size_t Count = static_cast<size_t>(-1))
+            {
+                Pool.Spin(Budget, BusyPoll, Count);
+            }
+
+            void Pin(bool Value = true)
+            {
+                Pool.Pin(Value);
+            }
+
+            void Pin(size_t Index, cpu_set_t const &CPUs)
+            {
+                Pool.Pin(Index, CPUs);
+            }
+
+            void LocalMemory(bool Value = true)
+            {
+                Pool.LocalMemory(Value);
+            }
+
+            void Compute(size_t Count)
+            {
+                Pool.Compute(Count);
+            }
+
+            template <typename TCallback>
+            void Watch(Duration const &Budget, TCallback &&OnStall, int Signal = 0)
+            {
+                Pool.Watch(Budget, std::forward<TCallback>(OnStall), Signal);
+            }
+
+            void MaxEvents(size_t Count)
+            {
+                Pool.MaxEvents(Count);
+            }
+
+            void Dispatch(Async::ThreadPool::Policies Policy)
+            {
+                Pool.Dispatch(Policy);
+            }
+
         private:
             Async::ThreadPool Pool;
             std::atomic<size_t> ConnectionCount{0};
@@ -141,10 +198,12 @@ namespace Core
                 size_t MaxConnectionCount;
                 bool NoDelay;
                 Duration Timeout;
+                size_t AcceptBatch;
             } Settings{
                 1024,
                 false,
-                {0, 0}};
+                {0, 0},
+                64};
         };
     }
 }
\ No newline at end of file
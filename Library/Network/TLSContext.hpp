@@ -264,6 +264,14 @@ namespace Core::Network
             CheckPrivateKey();
         }
 
+        TLSContext(TLSContext const &Other) : ctx(Other.ctx)
+        {
+            // Copies share the same context
+
+            if (ctx)
+                SSL_CTX_up_ref(ctx);
+        }
+
         TLSContext(TLSContext &&Other) : ctx(Other.ctx)
         {
             Other.ctx = nullptr;
@@ -1,7 +1,8 @@
 #pragma once
 
 #include <array>
-#include <list>
+#include <algorithm>
+#include <memory>
 
 #include <Duration.hpp>
 #include <Iterable/List.hpp>
@@ -21,64 +22,55 @@ namespace Core
             std::array<size_t, Stages> Position;
             size_t Bucket;
             size_t Wheel;
+
+            // Intrusive links, Next also chains the free list
+
+            Entry *Next = nullptr;
+            Entry *Previous = nullptr;
         };
 
+        /**
+         * @brief Intrusive doubly linked list of entries owned by the wheel's pool
+         */
         struct Bucket
         {
-            using Container = std::list<Entry>;
-            using Iterator = typename Container::iterator;
+            using Iterator = Entry *;
 
-            Container Entries;
+            Entry *Head = nullptr;
+            Entry *Tail = nullptr;
 
-            Iterator Add(Entry const &entry)
+            inline bool IsEmpty() const
             {
-                return Entries.insert(Entries.end(), entry);
+                return Head == nullptr;
             }
 
-            Iterator Add(Entry &&entry)
+            void Link(Entry *Item)
             {
-                return Entries.insert(Entries.end(), std::move(entry));
-            }
+                Item->Next = nullptr;
+                Item->Previous = Tail;
 
-            void Remove(Iterator entry)
-            {
-                Entries.erase(entry);
-            }
+                if (Tail)
+                    Tail->Next = Item;
+                else
+                    Head = Item;
 
-            void Execute()
-            {
-                if (Entries.size() <= 0)
-                    return;
-                    
-                for (auto &entry : Entries)
-                {
-                    if (entry.Callback)
-                        entry.Callback();
-                }
-
-                Entries.clear();
+                Tail = Item;
             }
 
-            void Cascade(Wheel &Destination, size_t Stage)
+            void Unlink(Entry *Item)
             {
-                // @todo Maybe user pointer to entry to make move faster?
-
-                while (!Entries.empty())
-                {
-                    auto Iterator = Entries.begin();
-
-                    // @todo Test this
-
-                    Iterator->Wheel = Stage;
-
-                    size_t &Index = Iterator->Position[Stage];
-
-                    auto &DestinationBucket = Destination.Buckets[Index].Entries;
-
-                    DestinationBucket.splice(DestinationBucket.end(), Entries, Iterator);
-                }
-
-                // bucket.clear();
+                if (Item->Previous)
+                    Item->Previous->Next = Item->Next;
+                else
+                    Head = Item->Next;
+
+                if (Item->Next)
+                    Item->Next->Previous = Item->Previous;
+                else
+                    Tail = Item->Previous;
+
+                Item->Next = nullptr;
+                Item->Previous = nullptr;
             }
         };
 
@@ -90,7 +82,11 @@ namespace Core
 
         TimeWheel() = default;
         TimeWheel(TimeWheel const &Other) = delete;
-        TimeWheel(TimeWheel &&Other) noexcept : Wheels(std::move(Other.Wheels)), Indices(std::move(Other.Indices)), IntervalMS(Other.IntervalMS) {}
+        TimeWheel(TimeWheel &&Other) noexcept : Wheels(std::move(Other.Wheels)), Indices(std::move(Other.Indices)), IntervalMS(Other.IntervalMS), Chunks(std::move(Other.Chunks)), Free(Other.Free)
+        {
+            Other.Wheels = {};
+            Other.Free = nullptr;
+        }
 
         TimeWheel(Duration const &Interval) : IntervalMS(Interval.AsMilliseconds())
         {
@@ -112,6 +108,11 @@ namespace Core
             Wheels = std::move(Other.Wheels);
             Indices = std::move(Other.Indices);
             IntervalMS = std::move(Other.IntervalMS);
+            Chunks = std::move(Other.Chunks);
+            Free = Other.Free;
+
+            Other.Wheels = {};
+            Other.Free = nullptr;
 
             return *this;
         }
@@ -149,24 +150,100 @@ namespace Core
         {
             Increment();
 
-            Current().Execute();
+            Execute(Current());
+        }
+
+        /**
+         * @brief Catches up with several elapsed ticks at once,
+         * jumping over the ones that have nothing to execute or cascade
+         * @param Count Number of elapsed ticks
+         */
+        void Advance(size_t Count)
+        {
+            while (Count)
+            {
+                size_t Next = NextDeadline();
+
+                if (!Next || Next > Count)
+                {
+                    Skip(Count);
+                    return;
+                }
+
+                Skip(Next - 1);
+                Tick();
+
+                Count -= Next;
+            }
+        }
+
+        /**
+         * @brief Ticks until the next tick that executes or cascades entries
+         * @return 0 if nothing is scheduled
+         */
+        size_t NextDeadline()
+        {
+            size_t Result = 0;
+            size_t Lower = 0;
+
+            for (size_t Level = 0; Level < Wheels.size(); Level++)
+            {
+                auto &_Wheel = Wheels[Level];
+
+                // Level 0 buckets execute, higher ones cascade once the level below wraps
+
+                for (size_t Distance = 1; Distance <= Steps; Distance++)
+                {
+                    size_t Ticks = Distance * _Wheel.Interval - Lower;
+
+                    if (Result && Ticks >= Result)
+                        break;
+
+                    if (!_Wheel.Buckets[(Indices[Level] + Distance) % Steps].IsEmpty())
+                    {
+                        Result = Ticks;
+                        break;
+                    }
+                }
+
+                Lower += Indices[Level] * _Wheel.Interval;
+            }
+
+            return Result;
         }
 
         template<typename TCallback>
         typename Bucket::Iterator Add(size_t _Steps, TCallback&& Callback)
         {
-            Entry entry{std::forward<TCallback>(Callback), Offset(_Steps), 0, 0};
+            // The current bucket has already run, so the soonest slot is the next tick
+
+            if (!_Steps)
+                _Steps = 1;
+
+            // Further than the top level can tell apart from the current tick
+
+            _Steps = std::min(_Steps, MaxSteps() - Wheels.back().Interval);
+
+            Entry *entry = Acquire();
+
+            entry->Callback = Function<void()>(std::forward<TCallback>(Callback));
+            entry->Position = Offset(_Steps);
+
+            // Parked on the highest level whose digit differs from the current tick,
+            // cascades then move it down by the digits of its absolute deadline
 
             size_t Level = 0;
 
-            for (Level = Wheels.size() - 1; Level > 0 && entry.Position[Level] == 0; --Level)
+            for (Level = Wheels.size() - 1; Level > 0 && entry->Position[Level] == Indices[Level]; --Level)
             {
             }
 
-            entry.Wheel = Level;
-            entry.Bucket = (entry.Position[Level] + Indices[Level]) % Wheels[Level].Buckets.size();
+            entry->Wheel = Level;
+            entry->Bucket = entry->Position[Level];
+
+            At(entry->Wheel, entry->Bucket).Link(entry);
 
-            return At(entry.Wheel, entry.Bucket).Add(std::move(entry));
+            return entry;
         }
 
         template<typename TCallback>
@@ -175,12 +252,17 @@ namespace Core
             return Add(Interval.AsMilliseconds() / IntervalMS, std::forward<TCallback>(Callback));
         }
 
+        /**
+         * @brief Cancels an entry, safe to call from inside any callback.
+         * An entry whose callback is running is released once it returns.
+         */
         inline void Remove(typename Bucket::Iterator Iterator)
         {
-            if (Iterator == end())
+            if (Iterator == end() || Iterator->Wheel == Detached)
                 return;
 
-            At(Iterator->Wheel, Iterator->Bucket).Remove(Iterator);
+            At(Iterator->Wheel, Iterator->Bucket).Unlink(Iterator);
+            Release(Iterator);
         }
 
         inline Bucket &At(size_t _Wheel, size_t _Bucket)
@@ -193,30 +275,113 @@ namespace Core
             return At(Stage, Indices[Stage]);
         }
 
-        inline auto end()
+        inline typename Bucket::Iterator end()
         {
-            return At(0, 0).Entries.end();
+            return nullptr;
         }
 
     private:
-        std::array<size_t, Stages> Offset(size_t _Steps)
+        static constexpr size_t ChunkSize = 256;
+        static constexpr size_t Detached = static_cast<size_t>(-1);
+
+        Entry *Acquire()
         {
-            std::array<size_t, Stages> Result;
+            if (!Free)
+            {
+                Chunks.Add(std::make_unique<Entry[]>(ChunkSize));
 
-            size_t Level = Wheels.size() - 1;
+                auto &Chunk = Chunks[Chunks.Length() - 1];
 
-            for (; _Steps && Level < Wheels.size(); --Level)
+                for (size_t i = ChunkSize; i > 0; i--)
+                {
+                    Chunk[i - 1].Wheel = Detached;
+                    Chunk[i - 1].Next = Free;
+                    Free = &Chunk[i - 1];
+                }
+            }
+
+            Entry *Item = Free;
+
+            Free = Item->Next;
+            Item->Next = nullptr;
+
+            return Item;
+        }
+
+        void Release(Entry *Item)
+        {
+            Item->Callback = Function<void()>();
+            Item->Wheel = Detached;
+            Item->Next = Free;
+            Item->Previous = nullptr;
+
+            Free = Item;
+        }
+
+        void Execute(Bucket &_Bucket)
+        {
+            // Entries are unlinked one at a time so callbacks may remove any other entry
+
+            while (Entry *Item = _Bucket.Head)
             {
-                auto &_Interval = Wheels[Level].Interval;
+                _Bucket.Unlink(Item);
+                Item->Wheel = Detached;
 
-                Result[Level] = _Steps / _Interval;
-                _Steps %= _Interval;
+                try
+                {
+                    if (Item->Callback)
+                        Item->Callback();
+                }
+                catch (...)
+                {
+                    Release(Item);
+                    throw;
+                }
+
+                Release(Item);
+            }
+        }
+
+        void Cascade(Bucket &Source, Wheel &Destination, size_t Stage)
+        {
+            while (Entry *Item = Source.Head)
+            {
+                Source.Unlink(Item);
+
+                Item->Wheel = Stage;
+                Item->Bucket = Item->Position[Stage];
+
+                Destination.Buckets[Item->Bucket].Link(Item);
             }
+        }
 
-            for (; Level < Wheels.size(); --Level)
+        void Skip(size_t Count)
+        {
+            for (size_t Level = 0; Count && Level < Wheels.size(); Level++)
             {
-                Result[Level] = 0;
+                size_t Sum = Indices[Level] + Count;
+
+                Indices[Level] = Sum % Steps;
+                Count = Sum / Steps;
             }
+        }
+
+        /**
+         * @brief Digits of the tick that lies the given steps ahead of the current one
+         */
+        std::array<size_t, Stages> Offset(size_t _Steps)
+        {
+            std::array<size_t, Stages> Result;
+
+            size_t Tick = _Steps;
+
+            for (size_t Level = 0; Level < Wheels.size(); Level++)
+                Tick += Indices[Level] * Wheels[Level].Interval;
+
+            Tick %= MaxSteps();
+
+            for (size_t Level = 0; Level < Wheels.size(); Level++)
+                Result[Level] = Tick / Wheels[Level].Interval % Steps;
 
             return Result;
         }
@@ -235,12 +400,15 @@ namespace Core
 
                 Increment(++Level);
 
-                Current(Level).Cascade(_Wheel, Level - 1);
+                Cascade(Current(Level), _Wheel, Level - 1);
             }
         }
 
         std::array<Wheel, Stages> Wheels;
         std::array<size_t, Stages> Indices;
         size_t IntervalMS;
+
+        Iterable::List<std::unique_ptr<Entry[]>> Chunks;
+        Entry *Free = nullptr;
     };
 }
\ No newline at end of file
@@ -76,7 +76,7 @@ namespace Core
         ePoll() = default;
 
         ePoll(ePoll const &) = delete;
-        ePoll(ePoll &&Other) noexcept : Descriptor(std::move(Other)) {}
+        ePoll(ePoll &&Other) noexcept : Descriptor(std::move(Other)), Calls(Other.Calls) {}
 
         ePoll(int Flags)
         {
@@ -87,6 +87,8 @@ namespace Core
         {
             Entry _Entry = Entry::From(Data, Events);
 
+            Calls++;
+
             if (epoll_ctl(_INode, int(Commands::Add), descriptor.INode(), (struct epoll_event *)&_Entry) == -1)
             {
                 throw std::system_error(errno, std::generic_category());
@@ -97,6 +99,8 @@ namespace Core
         {
             Entry _Entry = Entry::From(descriptor.INode(), Events);
 
+            Calls++;
+
             if (epoll_ctl(_INode, int(Commands::Add), descriptor.INode(), (struct epoll_event *)&_Entry) == -1)
             {
                 throw std::system_error(errno, std::generic_category());
@@ -107,6 +111,8 @@ namespace Core
         {
             Entry _Entry = Entry::From(Data, Events);
 
+            Calls++;
+
             epoll_ctl(_INode, int(Commands::Modify), descriptor.INode(), (struct epoll_event *)&_Entry);
         }
 
@@ -114,11 +120,15 @@ namespace Core
         {
             Entry _Entry = Entry::From(descriptor.INode(), Events);
 
+            Calls++;
+
             epoll_ctl(_INode, int(Commands::Modify), descriptor.INode(), (struct epoll_event *)&_Entry);
         }
 
         void Delete(const Descriptor &descriptor)
         {
+            Calls++;
+
             if (epoll_ctl(_INode, int(Commands::Delete), descriptor.INode(), (struct epoll_event *)nullptr) == -1)
             {
                 throw std::system_error(errno, std::generic_category());
@@ -134,6 +144,7 @@ namespace Core
             {
                 Count = epoll_wait(_INode, (struct epoll_event *)Items.Content(), static_cast<int>(Items.Capacity()), Timeout);
                 Saved = errno;
+                Calls++;
             } while (Count < 0 && Saved == EINTR);
 
             if (Count == -1)
@@ -149,8 +160,20 @@ namespace Core
         ePoll &operator=(ePoll &&Other) noexcept
         {
             Descriptor::operator=(std::move(Other));
+            Calls = Other.Calls;
 
             return *this;
         }
+
+        /**
+         * @brief epoll_ctl and epoll_wait calls made so far
+         */
+        inline size_t Syscalls() const
+        {
+            return Calls;
+        }
+
+    private:
+        size_t Calls = 0;
     };
 }
\ No newline at end of file
@@ -0,0 +1,483 @@
+#pragma once
+
+#include <cstring>
+#include <atomic>
+#include <endian.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+#include "Iterable/List.hpp"
+#include "Descriptor.hpp"
+#include "ePoll.hpp"
+
+namespace Core
+{
+    /**
+     * @brief io_uring based drop-in replacement for ePoll
+     * Interest changes are queued as poll requests and submitted together
+     * with the next wait in a single io_uring_enter call, so adding,
+     * modifying and deleting descriptors costs no syscall of its own.
+     * Poll requests are one-shot and re-armed on the following wait which
+     * keeps the level-triggered semantics callers of ePoll rely on, unless
+     * the registration itself asked for OneShot. EdgeTriggered registrations
+     * use a multishot poll instead which the kernel reports edge-triggered
+     * and which stays armed across waits.
+     * Only readiness is taken from the ring, reads, writes and accepts are
+     * still issued by the handlers as syscalls. A positive wait timeout is
+     * submitted as a ring timeout, which event loops use to wait for their
+     * next tick or the wheel's next deadline instead of a timer descriptor.
+     * Deleting submits the poll removal right away since the pending poll
+     * holds a reference to the file, which would otherwise keep a closed
+     * descriptor's socket open until the next wait.
+     * The kernel ring is only set up by the first wait. The kernel ties a ring
+     * to the thread that created it and interrupts that thread when the ring
+     * goes away, so a ring built by a loop's constructor on another thread
+     * would cost that thread a spurious EINTR once the loop dropped it.
+     */
+    class uRing : public Descriptor
+    {
+    public:
+        using Event = ePoll::Event;
+        using Entry = ePoll::Entry;
+        using List = ePoll::List;
+
+        uRing() = default;
+
+        uRing(uRing const &) = delete;
+        uRing(uRing &&Other) noexcept : Descriptor(std::move(Other))
+        {
+            Steal(Other);
+        }
+
+        /**
+         * @param Depth Submission queue entries, the completion queue gets
+         * twice as many which bounds the events a single wait returns
+         */
+        uRing(int Flags, unsigned Depth = 256) : SetupFlags(Flags), SetupDepth(Depth)
+        {
+        }
+
+        ~uRing()
+        {
+            Unmap();
+        }
+
+        void Add(const Descriptor &descriptor, uint32_t Events, uint64_t Data)
+        {
+            auto &Item = At(descriptor.INode());
+
+            Item.Data = Data;
+            Item.Events = Events;
+            Item.Active = true;
+            Item.Generation++;
+
+            // Armed by the first wait along with the ring
+
+            if (!SQRing)
+            {
+                Fired.Add(descriptor.INode());
+                return;
+            }
+
+            Arm(descriptor.INode(), Item);
+        }
+
+        void Modify(const Descriptor &descriptor, uint32_t Events, uint64_t Data)
+        {
+            auto &Item = At(descriptor.INode());
+
+            Item.Data = Data;
+
+            // A fired one-shot registration stays disarmed until modified
+
+            bool Rearm = !Item.Armed && Item.Active && (Events & ePoll::OneShot);
+
+            if (Item.Events == Events && !Rearm)
+                return;
+
+            Item.Events = Events;
+
+            if (Item.Armed)
+            {
+                Cancel(descriptor.INode(), Item);
+                Item.Generation++;
+                Arm(descriptor.INode(), Item);
+            }
+            else if (Rearm && SQRing)
+            {
+                Arm(descriptor.INode(), Item);
+            }
+        }
+
+        void Delete(const Descriptor &descriptor)
+        {
+            auto &Item = At(descriptor.INode());
+
+            if (Item.Armed)
+            {
+                Cancel(descriptor.INode(), Item);
+                Enter(0);
+            }
+
+            Item.Active = false;
+            Item.Generation++;
+        }
+
+        /**
+         * @brief io_uring_enter calls made so far
+         */
+        inline size_t Syscalls() const
+        {
+            return Calls;
+        }
+
+        void operator()(List &Items, int Timeout = -1)
+        {
+            if (!SQRing)
+                Setup();
+
+            // Re-arm descriptors that fired on the previous wait and are still registered
+
+            Fired.ForEach(
+                [this](int INode)
+                {
+                    auto &Item = Registrations[INode];
+
+                    if (Item.Active && !Item.Armed)
+                        Arm(INode, Item);
+                });
+
+            Fired.Free();
+
+            unsigned Wait = 0;
+
+            if (Timeout != 0 && IsCompletionEmpty())
+            {
+                Wait = 1;
+
+                if (Timeout > 0)
+                {
+                    TimeoutSpec.tv_sec = Timeout / 1000;
+                    TimeoutSpec.tv_nsec = (Timeout % 1000) * 1000000;
+
+                    // Completes on the first other completion or when it expires
+
+                    auto &SQE = Acquire();
+
+                    SQE.opcode = IORING_OP_TIMEOUT;
+                    SQE.fd = -1;
+                    SQE.addr = reinterpret_cast<uint64_t>(&TimeoutSpec);
+                    SQE.len = 1;
+                    SQE.off = 1;
+                    SQE.user_data = TimeoutTag;
+                }
+            }
+
+            if (Pending || Wait)
+                Enter(Wait);
+
+            Items.Length(0);
+
+            unsigned Head = *CQHead;
+            unsigned Tail = std::atomic_ref<unsigned>(*CQTail).load(std::memory_order_acquire);
+
+            while (Head != Tail && Items.Length() < Items.Capacity())
+            {
+                auto &CQE = CQEs[Head & *CQMask];
+                Head++;
+
+                if (CQE.user_data == TimeoutTag || CQE.user_data == RemoveTag)
+                    continue;
+
+                int INode = static_cast<int>(CQE.user_data & 0xFFFFFFFF);
+                uint32_t Generation = static_cast<uint32_t>(CQE.user_data >> 32);
+
+                if (static_cast<size_t>(INode) >= Registrations.Length())
+                    continue;
+
+                auto &Item = Registrations[INode];
+
+                // Skip completions of canceled or replaced requests
+
+                if (!Item.Active || Item.Generation != Generation)
+                    continue;
+
+                // Multishot polls stay armed for as long as the kernel flags more completions
+
+                if (!(CQE.flags & IORING_CQE_F_MORE))
+                {
+                    Item.Armed = false;
+
+                    if (!(Item.Events & ePoll::OneShot))
+                        Fired.Add(INode);
+                }
+
+                Items.Add(Entry::From(Item.Data, CQE.res < 0 ? static_cast<uint32_t>(ePoll::Error) : static_cast<uint32_t>(CQE.res)));
+            }
+
+            std::atomic_ref<unsigned>(*CQHead).store(Head, std::memory_order_release);
+        }
+
+        uRing &operator=(uRing const &Other) = delete;
+
+        uRing &operator=(uRing &&Other) noexcept
+        {
+            if (this != &Other)
+            {
+                Unmap();
+                Descriptor::operator=(std::move(Other));
+                Steal(Other);
+            }
+
+            return *this;
+        }
+
+    private:
+        struct Registration
+        {
+            uint64_t Data = 0;
+            uint32_t Events = 0;
+            uint32_t Generation = 0;
+            bool Active = false;
+            bool Armed = false;
+        };
+
+        static constexpr uint64_t TimeoutTag = ~0ull;
+        static constexpr uint64_t RemoveTag = ~0ull - 1;
+
+        // Rings
+
+        void *SQRing = nullptr;
+        void *CQRing = nullptr;
+        size_t SQRingSize = 0;
+        size_t CQRingSize = 0;
+
+        unsigned *SQHead = nullptr;
+        unsigned *SQTail = nullptr;
+        unsigned *SQMask = nullptr;
+        unsigned *SQArray = nullptr;
+        unsigned SQEntries = 0;
+        io_uring_sqe *SQEs = nullptr;
+
+        unsigned *CQHead = nullptr;
+        unsigned *CQTail = nullptr;
+        unsigned *CQMask = nullptr;
+        io_uring_cqe *CQEs = nullptr;
+
+        unsigned Pending = 0;
+        size_t Calls = 0;
+
+        int SetupFlags = 0;
+        unsigned SetupDepth = 0;
+
+        // State
+
+        Iterable::List<Registration> Registrations;
+        Iterable::List<int> Fired;
+        __kernel_timespec TimeoutSpec{0, 0};
+
+        void Setup()
+        {
+            io_uring_params Params;
+
+            std::memset(&Params, 0, sizeof(Params));
+
+            Params.flags = SetupFlags;
+
+            _INode = syscall(__NR_io_uring_setup, SetupDepth, &Params);
+
+            if (_INode < 0)
+            {
+                throw std::system_error(errno, std::generic_category());
+            }
+
+            Map(Params);
+        }
+
+        void Map(io_uring_params const &Params)
+        {
+            SQRingSize = Params.sq_off.array + Params.sq_entries * sizeof(unsigned);
+            CQRingSize = Params.cq_off.cqes + Params.cq_entries * sizeof(io_uring_cqe);
+
+            bool Single = Params.features & IORING_FEAT_SINGLE_MMAP;
+
+            if (Single)
+                SQRingSize = CQRingSize = std::max(SQRingSize, CQRingSize);
+
+            SQRing = mmap(nullptr, SQRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _INode, IORING_OFF_SQ_RING);
+
+            if (SQRing == MAP_FAILED)
+            {
+                SQRing = nullptr;
+                throw std::system_error(errno, std::generic_category());
+            }
+
+            CQRing = Single ? SQRing : mmap(nullptr, CQRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _INode, IORING_OFF_CQ_RING);
+
+            if (CQRing == MAP_FAILED)
+            {
+                CQRing = nullptr;
+                throw std::system_error(errno, std::generic_category());
+            }
+
+            SQEntries = Params.sq_entries;
+            SQEs = static_cast<io_uring_sqe *>(mmap(nullptr, SQEntries * sizeof(io_uring_sqe), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _INode, IORING_OFF_SQES));
+
+            if (SQEs == MAP_FAILED)
+            {
+                SQEs = nullptr;
+                throw std::system_error(errno, std::generic_category());
+            }
+
+            auto SQBase = static_cast<char *>(SQRing);
+            auto CQBase = static_cast<char *>(CQRing);
+
+            SQHead = reinterpret_cast<unsigned *>(SQBase + Params.sq_off.head);
+            SQTail = reinterpret_cast<unsigned *>(SQBase + Params.sq_off.tail);
+            SQMask = reinterpret_cast<unsigned *>(SQBase + Params.sq_off.ring_mask);
+            SQArray = reinterpret_cast<unsigned *>(SQBase + Params.sq_off.array);
+
+            CQHead = reinterpret_cast<unsigned *>(CQBase + Params.cq_off.head);
+            CQTail = reinterpret_cast<unsigned *>(CQBase + Params.cq_off.tail);
+            CQMask = reinterpret_cast<unsigned *>(CQBase + Params.cq_off.ring_mask);
+            CQEs = reinterpret_cast<io_uring_cqe *>(CQBase + Params.cq_off.cqes);
+        }
+
+        void Unmap()
+        {
+            if (SQEs)
+                munmap(SQEs, SQEntries * sizeof(io_uring_sqe));
+
+            if (CQRing && CQRing != SQRing)
+                munmap(CQRing, CQRingSize);
+
+            if (SQRing)
+                munmap(SQRing, SQRingSize);
+
+            SQEs = nullptr;
+            SQRing = nullptr;
+            CQRing = nullptr;
+        }
+
+        void Steal(uRing &Other)
+        {
+            SQRing = Other.SQRing;
+            CQRing = Other.CQRing;
+            SQRingSize = Other.SQRingSize;
+            CQRingSize = Other.CQRingSize;
+            SQHead = Other.SQHead;
+            SQTail = Other.SQTail;
+            SQMask = Other.SQMask;
+            SQArray = Other.SQArray;
+            SQEntries = Other.SQEntries;
+            SQEs = Other.SQEs;
+            CQHead = Other.CQHead;
+            CQTail = Other.CQTail;
+            CQMask = Other.CQMask;
+            CQEs = Other.CQEs;
+            Pending = Other.Pending;
+            Calls = Other.Calls;
+            SetupFlags = Other.SetupFlags;
+            SetupDepth = Other.SetupDepth;
+            Registrations = std::move(Other.Registrations);
+            Fired = std::move(Other.Fired);
+
+            Other.SQRing = nullptr;
+            Other.CQRing = nullptr;
+            Other.SQEs = nullptr;
+            Other.Pending = 0;
+        }
+
+        Registration &At(int INode)
+        {
+            while (Registrations.Length() <= static_cast<size_t>(INode))
+                Registrations.Add();
+
+            return Registrations[INode];
+        }
+
+        inline bool IsCompletionEmpty() const
+        {
+            return *CQHead == std::atomic_ref<unsigned>(*CQTail).load(std::memory_order_acquire);
+        }
+
+        io_uring_sqe &Acquire()
+        {
+            unsigned Tail = *SQTail;
+
+            if (Tail - std::atomic_ref<unsigned>(*SQHead).load(std::memory_order_acquire) >= SQEntries)
+            {
+                Enter(0);
+            }
+
+            unsigned Index = Tail & *SQMask;
+            auto &SQE = SQEs[Index];
+
+            std::memset(&SQE, 0, sizeof(SQE));
+
+            SQArray[Index] = Index;
+            std::atomic_ref<unsigned>(*SQTail).store(Tail + 1, std::memory_order_release);
+            Pending++;
+
+            return SQE;
+        }
+
+        void Arm(int INode, Registration &Item)
+        {
+            auto &SQE = Acquire();
+
+            uint32_t Events = Item.Events & ~static_cast<uint32_t>(ePoll::EdgeTriggered | ePoll::OneShot);
+
+#if __BYTE_ORDER == __BIG_ENDIAN
+            Events = (Events << 16) | (Events >> 16);
+#endif
+
+            SQE.opcode = IORING_OP_POLL_ADD;
+            SQE.fd = INode;
+            SQE.poll32_events = Events;
+
+            if ((Item.Events & ePoll::EdgeTriggered) && !(Item.Events & ePoll::OneShot))
+                SQE.len = IORING_POLL_ADD_MULTI;
+            SQE.user_data = (static_cast<uint64_t>(Item.Generation) << 32) | static_cast<uint32_t>(INode);
+
+            Item.Armed = true;
+        }
+
+        void Cancel(int INode, Registration &Item)
+        {
+            auto &SQE = Acquire();
+
+            SQE.opcode = IORING_OP_POLL_REMOVE;
+            SQE.fd = -1;
+            SQE.addr = (static_cast<uint64_t>(Item.Generation) << 32) | static_cast<uint32_t>(INode);
+            SQE.user_data = RemoveTag;
+
+            Item.Armed = false;
+        }
+
+        void Enter(unsigned Wait)
+        {
+            int Result = 0;
+            int Saved = 0;
+
+            do
+            {
+                Result = syscall(__NR_io_uring_enter, _INode, Pending, Wait, Wait ? IORING_ENTER_GETEVENTS : 0, nullptr, 0);
+                Saved = errno;
+                Calls++;
+
+                if (Result >= 0)
+                    Pending -= std::min(static_cast<unsigned>(Result), Pending);
+
+            } while (Result < 0 && Saved == EINTR);
+
+            // Completion queue is backed up, reap before submitting more
+
+            if (Result < 0 && Saved != EBUSY && Saved != EAGAIN)
+            {
+                throw std::system_error(Saved, std::generic_category());
+            }
+        }
+    };
+}
@@ -0,0 +1,111 @@
+#include <chrono>
+#include <vector>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#include <Network/Socket.hpp>
+#include <Network/TCPServer.hpp>
+#include <Test.hpp>
+
+using namespace Core;
+using namespace Core::Network;
+
+static EndPoint const Target{"127.0.0.1:48211"};
+
+/**
+ * @brief Connects Count clients at once to an echo server accepting up to
+ * Batch connections per wakeup, then sends one byte on each
+ * @return Milliseconds until every client got its byte back, zero if one didn't
+ */
+static double Storm(size_t Batch, size_t Count)
+{
+    TCPServer Server(
+        Target,
+        [](EndPoint const &, Duration const &)
+        {
+            return [](Async::EventLoop::Context &Context, ePoll::Entry &)
+            {
+                char Byte;
+                ssize_t Result = read(Context.Self.File.INode(), &Byte, 1);
+
+                if (Result == 1)
+                    Result = write(Context.Self.File.INode(), &Byte, 1);
+
+                if (Result <= 0)
+                    Context.Remove();
+            };
+        },
+        {0, 0}, 2, Duration::FromMilliseconds(10));
+
+    Server.AcceptBatch(Batch);
+    Server.MaxConnectionCount(Count * 2);
+    Server.Run();
+
+    std::vector<Socket> Clients;
+    timeval Timeout{2, 0};
+    bool Served = true;
+
+    auto Start = std::chrono::steady_clock::now();
+
+    // Handshakes complete in the kernel so the whole burst waits in the accept queue
+
+    for (size_t i = 0; i < Count; i++)
+    {
+        Clients.emplace_back(Socket::IPv4, Socket::TCP);
+        Clients.back().Connect(Target);
+        Clients.back().SetOptions(SOL_SOCKET, SO_RCVTIMEO, Timeout);
+    }
+
+    for (auto &Client : Clients)
+        Served &= write(Client.INode(), "x", 1) == 1;
+
+    for (auto &Client : Clients)
+    {
+        char Byte = 0;
+
+        Served &= read(Client.INode(), &Byte, 1) == 1 && Byte == 'x';
+    }
+
+    std::chrono::duration<double, std::milli> Elapsed = std::chrono::steady_clock::now() - Start;
+
+    Clients.clear();
+    Server.Stop();
+
+    return Served ? Elapsed.count() : 0;
+}
+
+int main(int, char const *[])
+{
+    Test::Test(
+        "Draining an empty accept queue reports no client",
+        []
+        {
+            Socket Listener(Socket::IPv4, Socket::TCP);
+
+            Listener.SetOptions(SOL_SOCKET, SO_REUSEADDR, static_cast<int>(1));
+            Listener.Bind(Target);
+            Listener.Listen();
+            Listener.Blocking(false);
+
+            auto [Client, Info] = Listener.TryAccept(SOCK_NONBLOCK);
+
+            Test::Assert(!Client);
+        });
+
+    Test::Test(
+        "Every connection of a burst is served",
+        []
+        {
+            Test::Assert(Storm(64, 1000) > 0);
+        });
+
+    // Connect storms accepted one connection per wakeup and in batches
+
+    for (size_t Count : {500, 2000})
+    {
+        for (size_t Batch : {1, 64})
+            Test::Log(Count, " connections, batches of ", Batch, " : ", Storm(Batch, Count), " ms");
+    }
+
+    return 0;
+}
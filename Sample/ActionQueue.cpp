@@ -0,0 +1,275 @@
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include <Function.hpp>
+#include <Iterable/List.hpp>
+#include <Async/EventLoop.hpp>
+#include <Test.hpp>
+
+using namespace Core;
+
+// The mutex guarded list the event loop used before ActionQueue, running the batch under the lock
+
+class MutexQueue
+{
+public:
+    template <typename TCallback>
+    void Add(TCallback &&Callback)
+    {
+        std::unique_lock lock(Mutex);
+
+        Actions.Add(std::forward<TCallback>(Callback));
+    }
+
+    size_t Run()
+    {
+        std::unique_lock lock(Mutex);
+
+        size_t Count = Actions.Length();
+
+        Actions.ForEach(
+            [](auto &Callback)
+            {
+                Callback();
+            });
+
+        Actions.Free();
+
+        return Count;
+    }
+
+private:
+    std::mutex Mutex;
+    Iterable::List<Function<void()>> Actions;
+};
+
+static void Spin(size_t Work)
+{
+    volatile size_t Count = 0;
+
+    while (Count < Work)
+        Count = Count + 1;
+}
+
+static size_t Monotonic()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct Result
+{
+    double Action = 0;
+    double Add = 0;
+    size_t Latency = 0;
+};
+
+/**
+ * @brief Feeds Count actions from each of Producers threads to a consumer
+ * draining the queue in a loop, every action spinning for Work iterations
+ * and producers spinning for Pace iterations between adds
+ * @return Nanoseconds per action overall, per Add on the producers and
+ * the 99th percentile from Add to run
+ */
+template <typename TQueue>
+static Result Feed(size_t Producers, size_t Count, size_t Work, size_t Pace = 0)
+{
+    TQueue Queue;
+    std::vector<size_t> Latencies;
+    std::atomic_size_t Adding{0};
+    std::atomic_bool Go{false};
+    std::vector<std::thread> Threads;
+
+    size_t Total = Producers * Count;
+
+    // Only the consumer runs actions so they record without synchronization
+
+    Latencies.reserve(Total);
+
+    for (size_t i = 0; i < Producers; i++)
+    {
+        Threads.emplace_back(
+            [&]
+            {
+                while (!Go.load(std::memory_order_acquire))
+                {
+                }
+
+                auto Start = std::chrono::steady_clock::now();
+
+                for (size_t k = 0; k < Count; k++)
+                {
+                    Queue.Add(
+                        [&Latencies, Work, Added = Monotonic()]
+                        {
+                            Latencies.push_back(Monotonic() - Added);
+                            Spin(Work);
+                        });
+
+                    Spin(Pace);
+                }
+
+                std::chrono::duration<double, std::nano> Elapsed = std::chrono::steady_clock::now() - Start;
+
+                Adding.fetch_add(Elapsed.count(), std::memory_order_relaxed);
+            });
+    }
+
+    auto Start = std::chrono::steady_clock::now();
+
+    Go.store(true, std::memory_order_release);
+
+    size_t Drained = 0;
+
+    while (Drained < Total)
+        Drained += Queue.Run();
+
+    std::chrono::duration<double, std::nano> Elapsed = std::chrono::steady_clock::now() - Start;
+
+    for (auto &Thread : Threads)
+        Thread.join();
+
+    Test::Assert(Latencies.size() == Total);
+
+    std::nth_element(Latencies.begin(), Latencies.begin() + Total * 99 / 100, Latencies.end());
+
+    return {Elapsed.count() / Total, static_cast<double>(Adding) / Total, Latencies[Total * 99 / 100]};
+}
+
+int main(int, char const *[])
+{
+    Test::Test(
+        "Every action runs once in per-producer order",
+        []
+        {
+            constexpr size_t Producers = 4;
+            constexpr size_t Count = 100000;
+
+            Async::ActionQueue Queue;
+            std::vector<size_t> Last(Producers, 0);
+            std::vector<std::thread> Threads;
+            bool Ordered = true;
+
+            for (size_t i = 0; i < Producers; i++)
+            {
+                Threads.emplace_back(
+                    [&, i]
+                    {
+                        for (size_t k = 1; k <= Count; k++)
+                        {
+                            Queue.Add(
+                                [&, i, k]
+                                {
+                                    Ordered &= Last[i] + 1 == k;
+                                    Last[i] = k;
+                                });
+                        }
+                    });
+            }
+
+            size_t Ran = 0;
+
+            while (Ran < Producers * Count)
+                Ran += Queue.Run();
+
+            for (auto &Thread : Threads)
+                Thread.join();
+
+            Test::Assert(Ordered, "Actions of a producer ran out of order");
+            Test::Assert(Queue.IsEmpty());
+
+            for (auto Value : Last)
+                Test::Assert(Value == Count);
+        });
+
+    Test::Test(
+        "Freeing releases actions without running them",
+        []
+        {
+            auto Token = std::make_shared<int>(0);
+            bool Ran = false;
+
+            {
+                Async::ActionQueue Queue;
+
+                for (size_t i = 0; i < 16; i++)
+                    Queue.Add([Token, &Ran]
+                              { Ran = true; });
+
+                Test::Assert(Token.use_count() == 17);
+            }
+
+            Test::Assert(!Ran && Token.use_count() == 1);
+        });
+
+    Test::Test(
+        "A throwing action doesn't drop the rest of the batch",
+        []
+        {
+            Async::ActionQueue Queue;
+            Iterable::List<int> Ran;
+            bool Threw = false;
+
+            Queue.Add([&] { Ran.Add(1); });
+            Queue.Add([] { throw std::runtime_error("Action failed"); });
+            Queue.Add([&] { Ran.Add(3); });
+
+            try
+            {
+                Queue.Run();
+            }
+            catch (std::runtime_error const &)
+            {
+                Threw = true;
+            }
+
+            Test::Assert(Threw, "Exception was swallowed");
+            Test::Assert(Ran.Length() == 2 && Ran[0] == 1 && Ran[1] == 3, "Action after the throwing one didn't run");
+            Test::Assert(Queue.IsEmpty());
+        });
+
+    Test::Test(
+        "Push reports the first action of a batch",
+        []
+        {
+            Async::ActionQueue Queue;
+
+            Test::Assert(Queue.Add([] {}));
+            Test::Assert(!Queue.Add([] {}));
+
+            Queue.Run();
+
+            Test::Assert(Queue.Add([] {}));
+            Queue.Free();
+        });
+
+    // Cost per action with producers contending against the draining loop,
+    // with empty actions and with actions doing some work under the old lock
+
+    for (size_t Work : {0, 100})
+    {
+        for (size_t Producers : {1, 2, 4, 8})
+        {
+            auto Mutex = Feed<MutexQueue>(Producers, 100000, Work);
+            auto Lockless = Feed<Async::ActionQueue>(Producers, 100000, Work);
+
+            Test::Log("Work ", Work, ", ", Producers, " producers : mutex ", Mutex.Action, " ns/action ", Mutex.Add, " ns/add, lock-free ", Lockless.Action, " ns/action ", Lockless.Add, " ns/add");
+        }
+    }
+
+    // Latency from Add to run with producers pacing themselves below the loop's throughput
+
+    for (size_t Producers : {1, 2, 4, 8})
+    {
+        auto Mutex = Feed<MutexQueue>(Producers, 5000, 0, 2000);
+        auto Lockless = Feed<Async::ActionQueue>(Producers, 5000, 0, 2000);
+
+        Test::Log(Producers, " paced producers : mutex ", Mutex.Latency, " ns p99, lock-free ", Lockless.Latency, " ns p99");
+    }
+
+    return 0;
+}
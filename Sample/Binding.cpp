@@ -0,0 +1,78 @@
+#include <atomic>
+#include <thread>
+
+#include <Event.hpp>
+#include <Async/ThreadPool.hpp>
+#include <Test.hpp>
+
+using namespace Core;
+using namespace Core::Async;
+
+int main(int, char const *[])
+{
+    Test::Test(
+        "Pinned runners record the CPU they were given",
+        []
+        {
+            ThreadPool Pool(Duration::FromMilliseconds(10), 2);
+            std::atomic_bool Running{true};
+
+            Pool.Pin();
+            Pool.LocalMemory();
+            Pool.Run([&] { return Running.load(); });
+
+            // Run only returns once the spawned loops recorded where they ended up
+
+            for (size_t i = 0; i < 2; i++)
+            {
+                auto const &Item = Pool.Bindings()[i];
+
+                Test::Assert(Item.Pinned && CPU_COUNT(&Item.CPUs) == 1, "Runner was not pinned");
+                Test::Assert(Item.CPU == Pool.PinnedCPU(i), "Runner started off its CPU");
+                Test::Assert(Item.Node >= 0);
+                Test::Assert(Item.LocalMemory, "Memory policy was not applied");
+            }
+
+            Running.store(false);
+            Pool.Stop();
+        });
+
+    Test::Test(
+        "Entries attached before the loop starts move to its runner's storage",
+        []
+        {
+            ThreadPool Pool(Duration::FromMilliseconds(10), 1);
+            auto &Joined = Pool[1];
+
+            std::atomic_bool Running{true};
+            std::atomic<size_t> Woken{0};
+            size_t Dispatched = 0;
+
+            // The joined loop belongs to this thread, so it takes entries before GetInPool
+
+            auto Id = Joined.Attach(Event(1, 0), [&](EventLoop::Context &, ePoll::Entry &) { Dispatched++; });
+            auto *Before = Joined.Find(Id);
+            EventLoop::Entry *After = nullptr;
+
+            Pool.Run([&] { return Running.load(); });
+
+            // The spawned loop's wake descriptor still works once relocated
+
+            Pool[0].Enqueue([&] { Woken++; });
+
+            Pool.GetInPool(
+                [&]
+                {
+                    After = Joined.Find(Id);
+                    return Dispatched < 1000 || !Woken.load();
+                });
+
+            Running.store(false);
+            Pool.Stop();
+
+            Test::Assert(After && After != Before, "Entry stayed in the constructing thread's storage");
+            Test::Assert(Woken.load() == 1);
+        });
+
+    return 0;
+}
@@ -0,0 +1,145 @@
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#include <Network/HTTP/Modules/Router.hpp>
+#include <Network/HTTP/Server.hpp>
+#include <Network/Socket.hpp>
+#include <Test.hpp>
+
+using namespace Core;
+using namespace Core::Network;
+
+static EndPoint const Target{"127.0.0.1:48212"};
+
+/**
+ * @brief Sends the raw requests on one connection and collects the response
+ * bodies that arrive until the server stays quiet for Quiet milliseconds
+ */
+static std::vector<std::string> Exchange(std::string const &Requests, long Quiet = 300)
+{
+    Socket Client(Socket::IPv4, Socket::TCP);
+    timeval Timeout{0, Quiet * 1000};
+    std::string Received;
+    char Chunk[4096];
+
+    Client.Connect(Target);
+    Client.SetOptions(SOL_SOCKET, SO_RCVTIMEO, Timeout);
+
+    Test::Assert(write(Client.INode(), Requests.data(), Requests.length()) == static_cast<ssize_t>(Requests.length()));
+
+    for (ssize_t Result; (Result = read(Client.INode(), Chunk, sizeof(Chunk))) > 0;)
+        Received.append(Chunk, Result);
+
+    std::vector<std::string> Bodies;
+    size_t Position = 0;
+
+    while (true)
+    {
+        size_t End = Received.find("\r\n\r\n", Position);
+        size_t Length = Received.find("ength: ", Position);
+
+        if (End == std::string::npos || Length == std::string::npos || Length > End)
+            break;
+
+        size_t Size = std::stoul(Received.substr(Length + 7));
+
+        Bodies.push_back(Received.substr(End + 4, Size));
+        Position = End + 4 + Size;
+    }
+
+    return Bodies;
+}
+
+int main(int, char const *[])
+{
+    HTTP::Server<HTTP::Modules::Router> Server(1, Duration::FromMilliseconds(10));
+
+    Server.SetDefault(
+        [](HTTP::Connection::Context &Context, HTTP::Request &Request)
+        {
+            auto Version = Request.Version;
+
+            if (Request.Path == "/twice")
+            {
+                // Completed twice on purpose, only the first one may answer
+
+                std::thread(
+                    [Token = Context.Defer(), Version]
+                    {
+                        Token.SendResponse(HTTP::Response::HTML(Version, HTTP::Status::OK, "first"));
+                        Token.SendResponse(HTTP::Response::HTML(Version, HTTP::Status::OK, "second"));
+                    })
+                    .detach();
+
+                return;
+            }
+
+            if (Request.Path == "/keep")
+            {
+                // The request is only read once the loop went on with other work
+
+                std::thread(
+                    [Token = Context.Defer(), &Request]
+                    {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                        Token.SendResponse(HTTP::Response::HTML(Request.Version, HTTP::Status::OK, Request.Path + " " + Request.Content));
+                    })
+                    .detach();
+
+                return;
+            }
+
+            if (Request.Path == "/late")
+            {
+                std::thread(
+                    [Token = Context.Defer(), Version]
+                    {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                        Token.SendResponse(HTTP::Response::HTML(Version, HTTP::Status::OK, "late"));
+                    })
+                    .detach();
+
+                return;
+            }
+
+            Context.SendResponse(HTTP::Response::HTML(Version, HTTP::Status::OK, Request.Path));
+        });
+
+    Server.IgnoreBrokenPipe().Listen({Target}).Run();
+
+    Test::Test(
+        "Deferred responses keep the pipeline order",
+        []
+        {
+            auto Bodies = Exchange("GET /late HTTP/1.1\r\n\r\nGET /now HTTP/1.1\r\n\r\n");
+
+            Test::Assert(Bodies.size() == 2 && Bodies[0] == "late" && Bodies[1] == "/now");
+        });
+
+    Test::Test(
+        "A token only answers its own request",
+        []
+        {
+            auto Bodies = Exchange("GET /twice HTTP/1.1\r\n\r\nGET /late HTTP/1.1\r\n\r\n");
+
+            Test::Assert(Bodies.size() == 2, "Stale completion sent a response");
+            Test::Assert(Bodies[0] == "first" && Bodies[1] == "late");
+        });
+
+    Test::Test(
+        "The request outlives its handler until the response is queued",
+        []
+        {
+            auto Bodies = Exchange("POST /keep HTTP/1.1\r\nContent-Length: 3\r\n\r\nabcGET /now HTTP/1.1\r\n\r\n");
+
+            Test::Assert(Bodies.size() == 2 && Bodies[0] == "/keep abc" && Bodies[1] == "/now");
+        });
+
+    Server.Stop();
+
+    return 0;
+}
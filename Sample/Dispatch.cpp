@@ -0,0 +1,146 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#include <Event.hpp>
+#include <Async/ThreadPool.hpp>
+#include <Test.hpp>
+
+using namespace Core;
+using namespace Core::Async;
+
+/**
+ * @brief Assigns Count idle socket ends to the loop and returns the peers,
+ * which have to stay open for the loop to keep them
+ */
+static Iterable::List<int> Load(EventLoop &Loop, size_t Count)
+{
+    Iterable::List<int> Peers(Count);
+
+    for (size_t i = 0; i < Count; i++)
+    {
+        int Pair[2];
+
+        socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, Pair);
+
+        Peers.Add(Pair[0]);
+        Loop.Assign(Descriptor(Pair[1]), [](EventLoop::Context &, ePoll::Entry &) {});
+    }
+
+    return Peers;
+}
+
+int main(int, char const *[])
+{
+    Test::Test(
+        "Round robin takes the loops in turn",
+        []
+        {
+            ThreadPool Pool(Duration::FromMilliseconds(10), 3);
+
+            Test::Assert(Pool.Dispatch() == ThreadPool::Policies::RoundRobin);
+
+            auto *First = &Pool.Next();
+
+            Test::Assert(&Pool.Next() != First && &Pool.Next() != First && &Pool.Next() == First);
+        });
+
+    Test::Test(
+        "Connection counting policies avoid the busier loop",
+        []
+        {
+            ThreadPool Pool(Duration::FromMilliseconds(10), 2);
+            std::atomic_bool Running{true};
+
+            Pool.Run([&] { return Running.load(); });
+
+            // Counted as soon as they're assigned, before the loop inserted them
+
+            auto Peers = Load(Pool[0], 3);
+
+            Test::Assert(Pool[0].Connections() == 3 && Pool[1].Connections() == 0);
+
+            for (auto Policy : {ThreadPool::Policies::LeastConnections, ThreadPool::Policies::PowerOfTwo})
+            {
+                Pool.Dispatch(Policy);
+
+                for (size_t i = 0; i < 10; i++)
+                    Test::Assert(&Pool.Next() == &Pool[1], "Picked the loop with more connections");
+            }
+
+            Running.store(false);
+            Pool.Stop();
+
+            Peers.ForEach([](int Peer) { close(Peer); });
+        });
+
+    Test::Test(
+        "A failed assignment isn't counted",
+        []
+        {
+            ThreadPool Pool(Duration::FromMilliseconds(10), 0, EventLoop::Backends::ePoll);
+            auto &Loop = Pool[0];
+            bool Threw = false;
+
+            // The joined loop belongs to this thread so the insert runs right away.
+            // epoll rejects the descriptor on the spot where the ring would only
+            // report it on the next wait
+
+            try
+            {
+                Loop.Assign(Descriptor(-1), [](EventLoop::Context &, ePoll::Entry &) {});
+            }
+            catch (std::system_error const &)
+            {
+                Threw = true;
+            }
+
+            Test::Assert(Threw && Loop.Connections() == 0, "Failed insert left the loop counted");
+        });
+
+    Test::Test(
+        "Least lag avoids the loop whose events queue up",
+        []
+        {
+            ThreadPool Pool(Duration::FromMilliseconds(10), 2);
+            std::atomic_bool Running{true};
+            std::atomic<size_t> Slow{0};
+
+            Pool.Dispatch(ThreadPool::Policies::LeastLag);
+
+            // Ten always ready events of a millisecond each on the first loop,
+            // the second one only wakes up for its own timer
+
+            Pool[0].Enqueue(
+                [&]
+                {
+                    for (size_t i = 0; i < 10; i++)
+                    {
+                        Pool[0].Attach(
+                            Event(1, 0),
+                            [&](EventLoop::Context &, ePoll::Entry &)
+                            {
+                                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                                Slow++;
+                            });
+                    }
+                });
+
+            Pool.Run([&] { return Running.load(); });
+
+            while (Slow.load() < 200)
+                std::this_thread::yield();
+
+            Test::Assert(Pool[0].Lag() >= 5000, "Queued events don't show as lag");
+
+            for (size_t i = 0; i < 10; i++)
+                Test::Assert(&Pool.Next() == &Pool[1], "Picked the lagging loop");
+
+            Running.store(false);
+            Pool.Stop();
+        });
+
+    return 0;
+}
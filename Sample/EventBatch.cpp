@@ -0,0 +1,81 @@
+// The test reads the events per wait off the loop metrics
+
+#ifndef COREKIT_METRICS
+#define COREKIT_METRICS
+#endif
+
+#include <chrono>
+
+#include <Event.hpp>
+#include <Async/ThreadPool.hpp>
+#include <Test.hpp>
+
+using namespace Core;
+using namespace Core::Async;
+
+/**
+ * @brief Attaches Count always readable events once the loop runs, then
+ * dispatches Total events with batches of at most Limit
+ * @return The loop metrics and the nanoseconds spent per event
+ */
+static std::pair<LoopMetrics::Snapshot, double> Storm(size_t Limit, size_t Count, size_t Total)
+{
+    ThreadPool Pool(Duration::FromMilliseconds(10), 0);
+    auto &Loop = Pool[0];
+
+    size_t Dispatched = 0;
+    std::chrono::steady_clock::time_point Start;
+
+    Loop.MaxEvents(Limit);
+
+    // Attaching from inside the loop makes it start from the smallest batch
+
+    Loop.Enqueue(
+        [&]
+        {
+            for (size_t i = 0; i < Count; i++)
+                Loop.Attach(Event(1, 0), [&](EventLoop::Context &, ePoll::Entry &) { Dispatched++; });
+
+            Start = std::chrono::steady_clock::now();
+        });
+
+    Pool.Run([] { return true; });
+    Pool.GetInPool([&] { return Dispatched < Total; });
+
+    std::chrono::duration<double, std::nano> Elapsed = std::chrono::steady_clock::now() - Start;
+
+    return {Loop.Metrics(), Elapsed.count() / Dispatched};
+}
+
+int main(int, char const *[])
+{
+    Test::Test(
+        "Full waits grow the batch up to the limit",
+        []
+        {
+            auto [Metrics, Time] = Storm(1024, 1000, 100000);
+
+            Test::Assert(Metrics.MaxEvents >= 1000, "Batch did not grow");
+            Test::Assert(Metrics.MaxEvents <= 1024, "Batch outgrew the limit");
+        });
+
+    Test::Test(
+        "A lower limit caps the batch",
+        []
+        {
+            auto [Metrics, Time] = Storm(64, 1000, 100000);
+
+            Test::Assert(Metrics.MaxEvents == 64);
+        });
+
+    // Cost per dispatched event with 1000 ready descriptors at each batch limit
+
+    for (size_t Limit : {16, 64, 1024})
+    {
+        auto [Metrics, Time] = Storm(Limit, 1000, 2000000);
+
+        Test::Log("Batches of up to ", Limit, " : ", Metrics.EventsPerWait(), " events/wait, ", Time, " ns/event");
+    }
+
+    return 0;
+}
@@ -0,0 +1,195 @@
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <optional>
+#include <stdexcept>
+#include <unordered_set>
+
+#include <Async/ThreadPool.hpp>
+#include <Async/Executor.hpp>
+#include <Async/Task.hpp>
+#include <Test.hpp>
+
+using namespace Core;
+using namespace Core::Async;
+
+/**
+ * @brief Runs Body on the only spawned loop of a pool whose loops offload
+ * to a dedicated executor of two workers, until Body sets Done
+ */
+template <typename TBody>
+static void Run(TBody &&Body)
+{
+    ThreadPool Pool(Duration::FromMilliseconds(10), 1);
+    std::atomic_bool Running{true};
+    std::atomic_bool Done{false};
+
+    Pool.Compute(2);
+    Pool.Run([&] { return Running.load(); });
+
+    Pool[0].Enqueue([&] { Body(Pool[0], Done); });
+
+    auto Start = std::chrono::steady_clock::now();
+
+    while (!Done.load() && std::chrono::steady_clock::now() - Start < std::chrono::seconds(2))
+        std::this_thread::yield();
+
+    Running.store(false);
+    Pool.Stop();
+
+    Test::Assert(Done.load(), "Timed out");
+}
+
+// Tasks terminate on exceptions so they only record what the tests check
+
+static Task Sum(EventLoop &Loop, std::optional<int> &Result, bool &Resumed, std::atomic_bool &Done)
+{
+    int Total = co_await Loop.Offload([] { return 40; });
+
+    try
+    {
+        co_await Loop.Offload([] { throw std::runtime_error("Failed"); });
+    }
+    catch (std::runtime_error const &)
+    {
+        Total += 2;
+    }
+
+    Resumed = EventLoop::Current() == &Loop;
+    Result = Total;
+    Done.store(true);
+}
+
+int main(int, char const *[])
+{
+    Test::Test(
+        "Every job runs once, including the ones jobs spawn",
+        []
+        {
+            Executor Pool(4);
+
+            constexpr size_t Outer = 1000;
+            constexpr size_t Inner = 100;
+
+            std::atomic<size_t> Runs{0};
+            std::mutex Lock;
+            std::unordered_set<std::thread::id> Threads;
+
+            // Jobs posted by a worker land on its own deque for the others to steal
+
+            for (size_t i = 0; i < Outer; i++)
+            {
+                Pool.Enqueue(
+                    [&]
+                    {
+                        for (size_t j = 0; j < Inner; j++)
+                            Pool.Enqueue([&] { Runs++; });
+
+                        std::lock_guard Guard(Lock);
+                        Threads.insert(std::this_thread::get_id());
+                    });
+            }
+
+            auto Start = std::chrono::steady_clock::now();
+
+            while (Runs.load() < Outer * Inner && std::chrono::steady_clock::now() - Start < std::chrono::seconds(5))
+                std::this_thread::yield();
+
+            Pool.Stop();
+
+            Test::Assert(Runs.load() == Outer * Inner, "Jobs were lost or run twice");
+            Test::Assert(Threads.size() > 1, "A single worker took every job");
+        });
+
+    Test::Test(
+        "Then gets the result on the offloading loop",
+        []
+        {
+            bool Offloaded = false;
+            bool Returned = false;
+
+            Run(
+                [&](EventLoop &Loop, std::atomic_bool &Done)
+                {
+                    Loop.Offload([] { return std::this_thread::get_id(); })
+                        .Then(
+                            [&](std::exception_ptr Error, std::optional<std::thread::id> Worker)
+                            {
+                                Offloaded = !Error && Worker && *Worker != std::this_thread::get_id();
+                                Returned = EventLoop::Current() == &Loop;
+
+                                Done.store(true);
+                            });
+                });
+
+            Test::Assert(Offloaded, "Job ran on the loop");
+            Test::Assert(Returned, "Continuation ran off the loop");
+        });
+
+    Test::Test(
+        "Errors are passed to the continuation",
+        []
+        {
+            bool Caught = false;
+
+            Run(
+                [&Caught](EventLoop &Loop, std::atomic_bool &Done)
+                {
+                    Loop.Offload([]() -> int { throw std::runtime_error("Failed"); })
+                        .Then(
+                            [&Caught, &Done](std::exception_ptr Error, std::optional<int> Result)
+                            {
+                                try
+                                {
+                                    if (Error)
+                                        std::rethrow_exception(Error);
+                                }
+                                catch (std::runtime_error const &)
+                                {
+                                    Caught = !Result;
+                                }
+
+                                Done.store(true);
+                            });
+                });
+
+            Test::Assert(Caught, "Error was lost");
+        });
+
+    Test::Test(
+        "co_await resumes on the loop with the result or the error",
+        []
+        {
+            std::optional<int> Result;
+            bool Resumed = false;
+
+            Run([&](EventLoop &Loop, std::atomic_bool &Done) { Sum(Loop, Result, Resumed, Done); });
+
+            Test::Assert(Result == 42 && Resumed);
+        });
+
+    // Cost per job submitted from outside the pool and run to completion
+
+    for (size_t Workers : {1, 2, 4})
+    {
+        Executor Pool(Workers);
+
+        constexpr size_t Jobs = 1000000;
+        std::atomic<size_t> Runs{0};
+
+        auto Start = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i < Jobs; i++)
+            Pool.Enqueue([&] { Runs.fetch_add(1, std::memory_order_relaxed); });
+
+        while (Runs.load() < Jobs)
+            std::this_thread::yield();
+
+        std::chrono::duration<double, std::nano> Elapsed = std::chrono::steady_clock::now() - Start;
+
+        Test::Log(Workers, " workers : ", Elapsed.count() / Jobs, " ns/job");
+    }
+
+    return 0;
+}
@@ -0,0 +1,206 @@
+#include <new>
+#include <chrono>
+#include <cstdlib>
+#include <typeinfo>
+#include <functional>
+
+#include <Function.hpp>
+#include <Test.hpp>
+
+using namespace Core;
+
+// Heap allocations still alive, to tell whether heap stored callables are freed.
+// Read it before building assertion messages, which allocate too
+
+static size_t Allocated = 0;
+
+void *operator new(size_t Size)
+{
+    Allocated++;
+
+    if (void *Result = std::malloc(Size))
+        return Result;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void *Pointer) noexcept
+{
+    if (Pointer)
+        Allocated--;
+
+    std::free(Pointer);
+}
+
+void operator delete(void *Pointer, size_t) noexcept
+{
+    operator delete(Pointer);
+}
+
+struct Small
+{
+    int Value;
+
+    int operator()() const
+    {
+        return Value;
+    }
+};
+
+struct Large
+{
+    size_t Values[4];
+
+    int operator()() const
+    {
+        return static_cast<int>(Values[0] + Values[3]);
+    }
+};
+
+// Counts live copies so leaks and double destruction both show up
+
+struct Tracked
+{
+    static inline int Live = 0;
+
+    size_t Padding[2] = {};
+
+    Tracked() { Live++; }
+    Tracked(Tracked const &) { Live++; }
+    ~Tracked() { Live--; }
+
+    int operator()() const
+    {
+        return 7;
+    }
+};
+
+static int Twice(int Value)
+{
+    return Value * 2;
+}
+
+template <typename TFunction, typename TCallback>
+static double Time(size_t Rounds, TCallback &&Make)
+{
+    volatile size_t Sum = 0;
+
+    auto Start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < Rounds; i++)
+    {
+        TFunction Callback = Make(i);
+        Sum = Sum + Callback();
+    }
+
+    std::chrono::duration<double, std::nano> Elapsed = std::chrono::steady_clock::now() - Start;
+
+    Test::Assert(Sum != 0);
+
+    return Elapsed.count() / Rounds;
+}
+
+int main(int, char const *[])
+{
+    Test::Test(
+        "Small callables are stored inline",
+        []
+        {
+            size_t Before = Allocated;
+
+            Function<int()> Callback(Small{5});
+            Function<int()> Copy(Callback);
+            Function<int()> Moved(std::move(Callback));
+
+            size_t After = Allocated;
+
+            Test::Assert(After == Before, "Small callable allocated");
+            Test::Assert(Copy() == 5 && Moved() == 5);
+            Test::Assert(!Callback, "Moved from function still set");
+        });
+
+    Test::Test(
+        "Large callables are freed once",
+        []
+        {
+            size_t Before = Allocated;
+
+            {
+                Function<int()> Callback(Large{{1, 2, 3, 4}});
+                Function<int()> Copy(Callback);
+                Function<int()> Moved(std::move(Callback));
+
+                Test::Assert(Copy() == 5 && Moved() == 5);
+
+                Copy = Function<int()>(Small{1});
+            }
+
+            size_t After = Allocated;
+
+            Test::Assert(After == Before, "Trivially destructible callable leaked");
+
+            {
+                Function<int()> Callback{Tracked{}};
+                Function<int()> Copy(Callback);
+
+                Test::Assert(Tracked::Live == 2);
+
+                Callback = std::move(Copy);
+
+                Test::Assert(Tracked::Live == 1 && Callback() == 7);
+            }
+
+            Test::Assert(Tracked::Live == 0, "Callable destroyed the wrong number of times");
+        });
+
+    Test::Test(
+        "Target finds inline and heap callables",
+        []
+        {
+            Function<int()> Inline(Small{9});
+            Function<int()> Heap(Large{{1, 0, 0, 1}});
+
+            Test::Assert(Inline.Target<Small>()->Value == 9);
+            Test::Assert(Heap.Target<Large>()->Values[3] == 1);
+
+            Inline.Target<Small>()->Value = 3;
+
+            Test::Assert(Inline() == 3);
+
+            bool Threw = false;
+
+            try
+            {
+                Inline.Target<Large>();
+            }
+            catch (std::bad_cast const &)
+            {
+                Threw = true;
+            }
+
+            Test::Assert(Threw, "Target of the wrong type");
+        });
+
+    Test::Test(
+        "Function pointers are copied by value",
+        []
+        {
+            Function<int(int)> Callback(&Twice);
+            Function<int(int)> Copy(Callback);
+
+            Callback.Clear();
+
+            Test::Assert(Copy(21) == 42);
+            Test::Assert(Copy.TypeName() == typeid(&Twice).name());
+        });
+
+    // Building and calling a callback once, the way queued actions and timers use them
+
+    constexpr size_t Rounds = 10000000;
+
+    Test::Log("Small : Function ", Time<Function<int()>>(Rounds, [](size_t i) { return Small{static_cast<int>(i | 1)}; }), " ns, std::function ", Time<std::function<int()>>(Rounds, [](size_t i) { return Small{static_cast<int>(i | 1)}; }), " ns");
+
+    Test::Log("Large : Function ", Time<Function<int()>>(Rounds, [](size_t i) { return Large{{i, 0, 0, 1}}; }), " ns, std::function ", Time<std::function<int()>>(Rounds, [](size_t i) { return Large{{i, 0, 0, 1}}; }), " ns");
+
+    return 0;
+}
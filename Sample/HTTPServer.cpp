@@ -202,7 +202,6 @@ int main(int, char const *[])
         .MaxBodySize(1024 * 1024 * 10)
         .MaxConnections(1024)
         .RequestBufferSize(256)
-        .ResponseBufferSize(256)
 
         // Enables TCP nodelay
 
@@ -0,0 +1,106 @@
+#include <chrono>
+#include <vector>
+
+#include <Event.hpp>
+#include <Async/ThreadPool.hpp>
+#include <Test.hpp>
+
+using namespace Core;
+using namespace Core::Async;
+
+static size_t Monotonic()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int main(int, char const *[])
+{
+    Test::Test(
+        "Refreshed handlers expire one timeout after their last activity",
+        []
+        {
+            ThreadPool Pool(Duration::FromMilliseconds(5), 0);
+            auto &Loop = Pool[0];
+
+            size_t LastRefresh = 0;
+            size_t Removed = 0;
+            size_t Refreshes = 0;
+
+            Loop.Enqueue(
+                [&]
+                {
+                    auto Id = Loop.Attach(
+                        Event(0, 0),
+                        [](EventLoop::Context &, ePoll::Entry &) {},
+                        [&]
+                        {
+                            Removed = Monotonic();
+                        },
+                        Duration::FromMilliseconds(100));
+
+                    LastRefresh = Monotonic();
+
+                    // Activity every 20 ms for 300 ms, well inside the timeout each time
+
+                    for (size_t i = 1; i <= 15; i++)
+                    {
+                        Loop.Schedule(
+                            Duration::FromMilliseconds(i * 20),
+                            [&, Id]
+                            {
+                                if (auto *Self = Loop.Find(Id))
+                                {
+                                    Loop.Reschedule(*Self, Duration::FromMilliseconds(100));
+                                    LastRefresh = Monotonic();
+                                    Refreshes++;
+                                }
+                            });
+                    }
+                });
+
+            size_t Start = Monotonic();
+
+            Pool.Run([] { return true; });
+            Pool.GetInPool([&] { return !Removed && Monotonic() - Start < 2000; });
+
+            Test::Assert(Refreshes == 15, "Handler expired while still active");
+            Test::Assert(Removed >= LastRefresh + 100, "Handler expired early");
+            Test::Assert(Removed <= LastRefresh + 140, "Handler expired late");
+        });
+
+    // Cost of the refresh done on every I/O event, lazily and by moving the wheel entry
+
+    for (size_t Live : {1000, 10000})
+    {
+        ThreadPool Pool(Duration::FromMilliseconds(1), 0);
+        auto &Loop = Pool[0];
+
+        std::vector<EventLoop::Handle> Handlers;
+
+        for (size_t i = 0; i < Live; i++)
+            Handlers.push_back(Loop.Attach(Event(0, 0), [](EventLoop::Context &, ePoll::Entry &) {}, nullptr, Duration(30, 0)));
+
+        constexpr size_t Rounds = 1000000;
+
+        auto Start = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i < Rounds; i++)
+            Loop.Reschedule(*Loop.Find(Handlers[i % Live]), Duration(30, 0));
+
+        std::chrono::duration<double, std::nano> Lazy = std::chrono::steady_clock::now() - Start;
+
+        Start = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i < Rounds; i++)
+        {
+            auto &Self = *Loop.Find(Handlers[i % Live]);
+            Self.Timer = Loop.Reschedule(Self.Timer, Duration(30, 0));
+        }
+
+        std::chrono::duration<double, std::nano> Eager = std::chrono::steady_clock::now() - Start;
+
+        Test::Log(Live, " handlers : lazy ", Lazy.count() / Rounds, " ns/refresh, remove and add ", Eager.count() / Rounds, " ns/refresh");
+    }
+
+    return 0;
+}
@@ -0,0 +1,143 @@
+// The syscall counts are read off the loop metrics
+
+#ifndef COREKIT_METRICS
+#define COREKIT_METRICS
+#endif
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#include <Network/HTTP/Modules/Router.hpp>
+#include <Network/HTTP/Server.hpp>
+#include <Network/Socket.hpp>
+#include <Test.hpp>
+
+using namespace Core;
+using namespace Core::Async;
+using namespace Core::Network;
+
+static EndPoint const Target{"127.0.0.1:48213"};
+
+/**
+ * @brief Backend syscalls a loop spends running Callback as one action,
+ * including the wait that woke it up
+ */
+template <typename TCallback>
+static uint64_t Spent(EventLoop &Loop, TCallback &&Callback)
+{
+    std::atomic<uint64_t> Before{0};
+    std::atomic_bool Done{false};
+
+    Loop.Enqueue(
+        [&]
+        {
+            Before.store(Loop.Metrics().Syscalls);
+            Callback();
+        });
+
+    // Recorded once the action's batch is dispatched, which the next action comes after
+
+    Loop.Enqueue([&] { Done.store(true); });
+
+    while (!Done.load())
+        std::this_thread::yield();
+
+    return Loop.Metrics().Syscalls - Before.load();
+}
+
+int main(int, char const *[])
+{
+    Test::Test(
+        "Unchanged interest isn't sent to the poller",
+        []
+        {
+            ThreadPool Pool(Duration::FromMilliseconds(10), 1, EventLoop::Backends::ePoll);
+            auto &Loop = Pool[0];
+
+            std::atomic_bool Running{true};
+            EventLoop::Handle Id;
+            int Pair[2];
+
+            socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, Pair);
+
+            Pool.Run([&] { return Running.load(); });
+
+            Loop.Enqueue([&] { Id = Loop.Attach(Descriptor(Pair[1]), [](EventLoop::Context &, ePoll::Entry &) {}); });
+
+            auto Unchanged = Spent(
+                Loop,
+                [&]
+                {
+                    for (size_t i = 0; i < 1000; i++)
+                        Loop.Modify(*Loop.Find(Id), ePoll::In);
+                });
+
+            // One-shot interest has to be re-armed every time
+
+            auto Rearmed = Spent(
+                Loop,
+                [&]
+                {
+                    for (size_t i = 0; i < 1000; i++)
+                        Loop.Modify(*Loop.Find(Id), ePoll::In | ePoll::OneShot);
+                });
+
+            Running.store(false);
+            Pool.Stop();
+            close(Pair[0]);
+
+            Test::Assert(Unchanged < 10, "Unchanged interest reached the poller");
+            Test::Assert(Rearmed >= 1000, "One-shot interest was not re-armed");
+        });
+
+    Test::Test(
+        "Responses that fit the socket don't arm writes",
+        []
+        {
+            HTTP::Server<HTTP::Modules::Router> Server(1, Duration::FromMilliseconds(10));
+
+            Server.SetDefault(
+                [](HTTP::Connection::Context &Context, HTTP::Request &Request)
+                {
+                    Context.SendResponse(HTTP::Response::HTML(Request.Version, HTTP::Status::OK, "ok"));
+                });
+
+            Server.IgnoreBrokenPipe().Listen({Target}).Run();
+
+            Socket Client(Socket::IPv4, Socket::TCP);
+            std::string Request = "GET / HTTP/1.1\r\nHost: localhost\r\n\r\n";
+            char Chunk[4096];
+
+            Client.Connect(Target);
+
+            auto Exchange = [&]
+            {
+                Test::Assert(write(Client.INode(), Request.data(), Request.length()) == static_cast<ssize_t>(Request.length()));
+                Test::Assert(read(Client.INode(), Chunk, sizeof(Chunk)) > 0, "Request was not answered");
+            };
+
+            // Accepting and registering the connection is left out
+
+            Exchange();
+
+            constexpr size_t Requests = 1000;
+            uint64_t Before = Server.ThreadPool().Metrics().Syscalls;
+
+            for (size_t i = 0; i < Requests; i++)
+                Exchange();
+
+            double PerRequest = static_cast<double>(Server.ThreadPool().Metrics().Syscalls - Before) / Requests;
+
+            Server.Stop();
+
+            // A wait per request, arming and disarming Out would add two epoll_ctl calls
+
+            Test::Log("Backend syscalls per request : ", PerRequest);
+            Test::Assert(PerRequest < 1.5, "Responses went through the poller");
+        });
+
+    return 0;
+}
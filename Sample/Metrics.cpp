@@ -0,0 +1,141 @@
+// The metrics are only recorded when this is defined
+
+#ifndef COREKIT_METRICS
+#define COREKIT_METRICS
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <Event.hpp>
+#include <Async/ThreadPool.hpp>
+#include <Test.hpp>
+
+using namespace Core;
+using namespace Core::Async;
+
+/**
+ * @brief Runs a pool of two spawned loops with a 10ms timer interval while
+ * Body works with the first one, then returns the metrics of both
+ */
+template <typename TBody>
+static std::pair<LoopMetrics::Snapshot, LoopMetrics::Snapshot> Measure(TBody &&Body)
+{
+    ThreadPool Pool(Duration::FromMilliseconds(10), 2);
+    std::atomic_bool Running{true};
+
+    Pool.Run([&] { return Running.load(); });
+
+    Body(Pool[0]);
+
+    Running.store(false);
+    Pool.Stop();
+
+    auto Total = Pool.Metrics();
+    auto First = Pool[0].Metrics();
+    auto Second = Pool[1].Metrics();
+
+    Test::Assert(Total.Waits == First.Waits + Second.Waits && Total.Syscalls == First.Syscalls + Second.Syscalls, "Pool metrics don't add up");
+
+    return {First, Second};
+}
+
+static void Sleep(size_t Milliseconds)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(Milliseconds));
+}
+
+int main(int, char const *[])
+{
+    Test::Test(
+        "Callback durations and utilization",
+        []
+        {
+            std::atomic<size_t> Calls{0};
+
+            auto [Busy, Idle] = Measure(
+                [&](EventLoop &Loop)
+                {
+                    Loop.Enqueue(
+                        [&]
+                        {
+                            Loop.Attach(
+                                Event(1, 0),
+                                [&](EventLoop::Context &, ePoll::Entry &)
+                                {
+                                    Sleep(1);
+                                    Calls++;
+                                });
+                        });
+
+                    while (Calls.load() < 100)
+                        std::this_thread::yield();
+                });
+
+            // Sleeping a millisecond lands in [1024, 2048) or a bucket or two above
+
+            auto Median = Busy.CallbackPercentile(0.5);
+
+            Test::Assert(Median >= 2048 && Median <= 8192, "Callbacks counted in the wrong bucket");
+            Test::Assert(Busy.Utilization() > 0.5, "Busy loop reads as idle");
+            Test::Assert(Idle.Utilization() < 0.5, "Idle loop reads as busy");
+            Test::Assert(Busy.Syscalls >= Busy.Waits, "Waits are syscalls too");
+        });
+
+    Test::Test(
+        "Actions posted during a long one run in the next wakeup",
+        []
+        {
+            std::atomic<size_t> Ran{0};
+
+            auto [Busy, Idle] = Measure(
+                [&](EventLoop &Loop)
+                {
+                    Loop.Enqueue([&] { Sleep(50); });
+
+                    for (size_t i = 0; i < 100; i++)
+                        Loop.Enqueue([&] { Ran++; });
+
+                    while (Ran.load() < 100)
+                        std::this_thread::yield();
+                });
+
+            Test::Assert(Busy.Actions == 101);
+            Test::Assert(Busy.MaxActionsPerWakeup >= 100, "Backlog split over several wakeups");
+            Test::Assert(Busy.Wakeups <= 2);
+        });
+
+    Test::Test(
+        "A blocked loop runs its missed ticks at once",
+        []
+        {
+            std::atomic_bool Done{false};
+
+            auto [Busy, Idle] = Measure(
+                [&](EventLoop &Loop)
+                {
+                    Sleep(50);
+
+                    Loop.Enqueue(
+                        [&]
+                        {
+                            Sleep(50);
+                            Done.store(true);
+                        });
+
+                    while (!Done.load())
+                        std::this_thread::yield();
+
+                    Sleep(50);
+                });
+
+            // Lag is taken against the latest expiration the timer read returned
+
+            Test::Assert(Busy.Ticks && Idle.Ticks, "Timer never ran");
+            Test::Assert(Busy.Ticks + 3 <= Idle.Ticks, "Missed ticks were run one by one");
+            Test::Assert(Busy.MaxLag < 10000, "Lag counted the ticks that were caught up");
+        });
+
+    return 0;
+}
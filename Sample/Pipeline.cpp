@@ -0,0 +1,175 @@
+#include <chrono>
+#include <string>
+#include <iostream>
+
+#include <Iterable/Queue.hpp>
+#include <Network/HTTP/Parser.hpp>
+#include <Network/HTTP/Request.hpp>
+#include <Test.hpp>
+
+using namespace Core;
+using namespace Core::Network;
+
+// Parses pipelined requests the way Connection::Dispatch does, straight out of the buffer
+
+static size_t ParseAll(HTTP::Parser<HTTP::Request> &Parser, Iterable::Queue<char> &Buffer)
+{
+    size_t Count = 0;
+
+    while (!Buffer.IsEmpty())
+    {
+        Parser();
+
+        if (!Parser.IsFinished())
+            break;
+
+        Count++;
+        Parser.Reset();
+    }
+
+    return Count;
+}
+
+static void Fill(Iterable::Queue<char> &Buffer, std::string const &Batch)
+{
+    Buffer.CopyFrom(Batch.data(), Batch.length());
+}
+
+static std::string Batch(size_t Depth)
+{
+    std::string Result;
+
+    for (size_t i = 0; i < Depth; i++)
+        Result += "GET /plaintext HTTP/1.1\r\nHost: localhost\r\nAccept: text/plain\r\nConnection: keep-alive\r\n\r\n";
+
+    return Result;
+}
+
+int main(int, char const *[])
+{
+    Test::Test(
+        "Pipelined requests past the header limit",
+        []
+        {
+            Iterable::Queue<char> Buffer;
+            HTTP::Parser<HTTP::Request> Parser(1024, 0, 1024, Buffer);
+
+            auto Requests = Batch(256);
+
+            Test::Assert(Requests.length() > 16 * Parser.HeaderLimit);
+
+            Fill(Buffer, Requests);
+
+            Test::Assert(ParseAll(Parser, Buffer) == 256, "Not every request was parsed");
+            Test::Assert(Buffer.IsEmpty());
+        });
+
+    Test::Test(
+        "Body followed by pipelined requests",
+        []
+        {
+            Iterable::Queue<char> Buffer;
+            HTTP::Parser<HTTP::Request> Parser(512, 0, 1024, Buffer);
+
+            std::string Requests = "POST /a HTTP/1.1\r\nContent-Length: 2000\r\n\r\n" + std::string(2000, 'x') +
+                                   "POST /b HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n3\r\nabc\r\n0\r\n\r\n" +
+                                   Batch(32);
+
+            Fill(Buffer, Requests);
+
+            Parser();
+            Test::Assert(Parser.IsFinished() && Parser.Result.Content.length() == 2000);
+            Parser.Reset();
+
+            Parser();
+            Test::Assert(Parser.IsFinished() && Parser.Result.Content == "abc");
+            Parser.Reset();
+
+            Test::Assert(ParseAll(Parser, Buffer) == 32);
+        });
+
+    Test::Test(
+        "Oversized header block",
+        []
+        {
+            Iterable::Queue<char> Buffer;
+            HTTP::Parser<HTTP::Request> Parser(256, 0, 1024, Buffer);
+
+            Fill(Buffer, "GET / HTTP/1.1\r\nX-Long: " + std::string(512, 'a') + "\r\n\r\n");
+
+            Test::MustThrow([&] { Parser(); });
+        });
+
+    Test::Test(
+        "Content-Length must be all digits",
+        []
+        {
+            for (bool ZeroCopy : {false, true})
+            {
+                for (std::string Length : {"+5", " 5", "5 ", "5x", "-1", "99999999999999999999999"})
+                {
+                    Iterable::Queue<char> Buffer;
+                    HTTP::Parser<HTTP::Request> Parser(1024, 0, 1024, Buffer, false, ZeroCopy);
+                    bool Rejected = false;
+
+                    Fill(Buffer, "POST / HTTP/1.1\r\nContent-Length: " + Length + "\r\n\r\nabcde");
+
+                    try
+                    {
+                        Parser();
+                    }
+                    catch (HTTP::Status Status)
+                    {
+                        Rejected = Status == HTTP::Status::BadRequest;
+                    }
+
+                    Test::Assert(Rejected, "Accepted Content-Length '" + Length + "'");
+                }
+
+                Iterable::Queue<char> Buffer;
+                HTTP::Parser<HTTP::Request> Parser(1024, 0, 1024, Buffer, false, ZeroCopy);
+
+                Fill(Buffer, "POST / HTTP/1.1\r\nContent-Length: 5\r\n\r\nabcde");
+
+                Parser();
+                Test::Assert(Parser.IsFinished() && Parser.ContentLength == 5);
+
+                // A copy is looked up by name
+
+                Parser.Result.Materialize();
+
+                HTTP::Request Copy = Parser.Result;
+
+                Test::Assert(Copy.Header(HTTP::HeaderId::ContentLength) == "5");
+            }
+        });
+
+    // Parse time per request at the pipeline depths of wrk's pipeline.lua
+
+    for (bool ZeroCopy : {false, true})
+    {
+        for (size_t Depth : {1, 16, 64})
+        {
+            Iterable::Queue<char> Buffer;
+            HTTP::Parser<HTTP::Request> Parser(16 * 1024, 0, 1024, Buffer, false, ZeroCopy);
+
+            auto Requests = Batch(Depth);
+            size_t Rounds = 200000 / Depth;
+            size_t Parsed = 0;
+
+            auto Start = std::chrono::steady_clock::now();
+
+            for (size_t i = 0; i < Rounds; i++)
+            {
+                Fill(Buffer, Requests);
+                Parsed += ParseAll(Parser, Buffer);
+            }
+
+            std::chrono::duration<double, std::nano> Elapsed = std::chrono::steady_clock::now() - Start;
+
+            Test::Log(ZeroCopy ? "Zero-copy" : "Copying", " depth ", Depth, " : ", Elapsed.count() / Parsed, " ns/request");
+        }
+    }
+
+    return 0;
+}
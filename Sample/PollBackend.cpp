@@ -0,0 +1,224 @@
+// The syscall counts are read off the loop metrics
+
+#ifndef COREKIT_METRICS
+#define COREKIT_METRICS
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#include <Async/ThreadPool.hpp>
+#include <Test.hpp>
+
+using namespace Core;
+using namespace Core::Async;
+
+using Backends = EventLoop::Backends;
+
+static char const *Name(Backends Kind)
+{
+    return Kind == Backends::uRing ? "uRing" : "ePoll";
+}
+
+/**
+ * @brief Syscalls spent on each request, split between the loop's
+ * backend and the reads and writes of the handlers
+ */
+struct Cost
+{
+    double Backend = 0;
+    double Handlers = 0;
+    double Time = 0; // Nanoseconds per request
+    size_t Served = 0;
+};
+
+/**
+ * @brief Sends one byte on each of Count connections and waits for every
+ * echo, Rounds times over. With Churn every request gets a new connection
+ * that the handler removes once it answered, otherwise the connections
+ * are kept open across rounds
+ */
+static Cost Serve(Backends Kind, size_t Count, size_t Rounds, bool Churn)
+{
+    ThreadPool Pool(Duration::FromMilliseconds(10), 1, Kind);
+    auto &Loop = Pool[0];
+
+    std::atomic_bool Running{true};
+    size_t Calls = 0;
+    size_t Served = 0;
+
+    auto Echo = [&](EventLoop::Context &Context, ePoll::Entry &)
+    {
+        char Byte;
+
+        Calls++;
+
+        if (Context.Self.File.Read(&Byte, 1) != 1)
+            return;
+
+        Calls++;
+
+        if (Context.Self.File.Write(&Byte, 1) == 1)
+            Served++;
+
+        if (Churn)
+            Context.Remove();
+    };
+
+    Pool.Run([&] { return Running.load(); });
+
+    std::vector<int> Clients(Count, -1);
+
+    auto Connect = [&](Iterable::List<EventLoop::Assignment> &Batch)
+    {
+        for (auto &Client : Clients)
+        {
+            int Pair[2];
+
+            socketpair(AF_UNIX, SOCK_STREAM, 0, Pair);
+            fcntl(Pair[1], F_SETFL, O_NONBLOCK);
+
+            Client = Pair[0];
+            Batch.Add(EventLoop::Assignment{Descriptor(Pair[1]), Echo, nullptr});
+        }
+    };
+
+    auto Exchange = [&]
+    {
+        char Byte = 'x';
+
+        for (int Client : Clients)
+            Test::Assert(write(Client, &Byte, 1) == 1);
+
+        for (int Client : Clients)
+            Test::Assert(read(Client, &Byte, 1) == 1, "Request was not answered");
+    };
+
+    if (!Churn)
+    {
+        Iterable::List<EventLoop::Assignment> Batch(Count);
+
+        Connect(Batch);
+        Loop.Assign(std::move(Batch));
+        Exchange();
+    }
+
+    uint64_t Before = Loop.Metrics().Syscalls;
+    size_t Handled = Calls;
+    size_t Answered = Served;
+
+    auto Start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < Rounds; i++)
+    {
+        if (Churn)
+        {
+            Iterable::List<EventLoop::Assignment> Batch(Count);
+
+            Connect(Batch);
+            Loop.Assign(std::move(Batch));
+        }
+
+        Exchange();
+
+        if (Churn)
+        {
+            for (int &Client : Clients)
+                close(std::exchange(Client, -1));
+        }
+    }
+
+    std::chrono::duration<double, std::nano> Elapsed = std::chrono::steady_clock::now() - Start;
+
+    Running.store(false);
+    Pool.Stop();
+
+    for (int Client : Clients)
+    {
+        if (Client != -1)
+            close(Client);
+    }
+
+    double Requests = static_cast<double>(Count * Rounds);
+
+    return {(Loop.Metrics().Syscalls - Before) / Requests, (Calls - Handled) / Requests, Elapsed.count() / Requests, Served - Answered};
+}
+
+int main(int, char const *[])
+{
+    for (auto Kind : {Backends::ePoll, Backends::uRing})
+    {
+        Test::Test(
+            std::string(Name(Kind)) + " : Removing a descriptor closes it right away",
+            [Kind]
+            {
+                ThreadPool Pool(Duration::FromMilliseconds(10), 1, Kind);
+                auto &Loop = Pool[0];
+
+                std::atomic_bool Running{true};
+                std::atomic_int Closed{-1};
+                std::atomic<uint64_t> Id{0};
+                int Pair[2];
+
+                socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, Pair);
+
+                Pool.Run([&] { return Running.load(); });
+
+                Test::Assert(Loop.Backend() == Kind);
+
+                Loop.Enqueue([&] { Id.store(Loop.Attach(Descriptor(Pair[1]), [](EventLoop::Context &, ePoll::Entry &) {}).Pack()); });
+
+                while (!Id.load())
+                    std::this_thread::yield();
+
+                // The poll is in the kernel by now, the peer is checked before
+                // the loop waits again which used to be what submitted the removal
+
+                Loop.Enqueue(
+                    [&]
+                    {
+                        Loop.Remove(EventLoop::Handle::Unpack(Id.load()));
+
+                        pollfd Peer{Pair[0], POLLIN, 0};
+                        char Byte;
+
+                        Closed.store(poll(&Peer, 1, 0) == 1 && read(Pair[0], &Byte, 1) == 0);
+                    });
+
+                while (Closed.load() == -1)
+                    std::this_thread::yield();
+
+                Running.store(false);
+                Pool.Stop();
+                close(Pair[0]);
+
+                Test::Assert(Closed.load() == 1, "Peer saw no hang up");
+            });
+
+        Test::Test(
+            std::string(Name(Kind)) + " : Every request is answered",
+            [Kind]
+            {
+                Test::Assert(Serve(Kind, 100, 10, false).Served == 1000);
+                Test::Assert(Serve(Kind, 100, 10, true).Served == 1000);
+            });
+    }
+
+    // Syscalls per request with 1000 connections sending one request each at a time
+
+    for (bool Churn : {false, true})
+    {
+        for (auto Kind : {Backends::ePoll, Backends::uRing})
+        {
+            auto Result = Serve(Kind, 1000, Churn ? 50 : 200, Churn);
+
+            Test::Log(Churn ? "New connection per request, " : "Kept alive, ", Name(Kind), " : ", Result.Backend, " backend + ", Result.Handlers, " handler syscalls/request, ", Result.Time, " ns/request");
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include <chrono>
+#include <random>
+#include <string>
+
+#include <Network/HTTP/Scanner.hpp>
+#include <Test.hpp>
+
+using namespace Core;
+using namespace Core::Network;
+
+// Byte at a time references of what the scanner looks for
+
+static size_t ValueEnd(std::string_view Text, size_t From)
+{
+    for (size_t i = From; i < Text.length(); i++)
+    {
+        unsigned char Character = Text[i];
+
+        if ((Character < 0x20 && Character != '\t') || Character == 0x7f)
+            return i;
+    }
+
+    return HTTP::Scanner::npos;
+}
+
+static size_t TargetEnd(std::string_view Text, size_t From)
+{
+    for (size_t i = From; i < Text.length(); i++)
+    {
+        unsigned char Character = Text[i];
+
+        if (Character <= 0x20 || Character == 0x7f)
+            return i;
+    }
+
+    return HTTP::Scanner::npos;
+}
+
+template <typename TCallback>
+static double Time(size_t Rounds, TCallback &&Callback)
+{
+    size_t Sum = 0;
+
+    auto Start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < Rounds; i++)
+        Sum += Callback();
+
+    std::chrono::duration<double, std::nano> Elapsed = std::chrono::steady_clock::now() - Start;
+
+    Test::Assert(Sum != 0);
+
+    return Elapsed.count() / Rounds;
+}
+
+int main(int, char const *[])
+{
+    Test::Test(
+        "Vector scans agree with byte at a time scans",
+        []
+        {
+            std::mt19937 Random(1);
+            char const Alphabet[] = "ab:\r\n\t \x01\x7f\x80 /?=";
+
+            for (size_t Round = 0; Round < 200000; Round++)
+            {
+                std::string Text(Random() % 120, 'x');
+
+                for (auto &Character : Text)
+                    Character = Random() % 3 ? 'a' + Random() % 26 : Alphabet[Random() % (sizeof(Alphabet) - 1)];
+
+                size_t From = Text.empty() ? 0 : Random() % Text.length();
+
+                Test::Assert(HTTP::Scanner::Terminator(Text, From) == std::string_view(Text).find("\r\n\r\n", From));
+                Test::Assert(HTTP::Scanner::ValueEnd(Text, From) == ValueEnd(Text, From));
+                Test::Assert(HTTP::Scanner::TargetEnd(Text, From) == TargetEnd(Text, From));
+            }
+        });
+
+    // A browser-sized request head, the scanner against the byte at a time loops
+
+    std::string Head = "GET /api/v1/items?page=2&sort=name HTTP/1.1\r\n"
+                       "Host: www.example.com\r\n"
+                       "User-Agent: Mozilla/5.0 (X11; Linux x86_64; rv:128.0) Gecko/20100101 Firefox/128.0\r\n"
+                       "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,image/avif,image/webp,*/*;q=0.8\r\n"
+                       "Accept-Language: en-US,en;q=0.5\r\n"
+                       "Accept-Encoding: gzip, deflate, br, zstd\r\n"
+                       "Cookie: session=6f1c2a9e8b7d4c3f2e1d0c9b8a7f6e5d; theme=dark; consent=1\r\n"
+                       "Connection: keep-alive\r\n"
+                       "\r\n";
+
+    std::string_view Text(Head);
+    constexpr size_t Rounds = 2000000;
+
+    Test::Log("Level ", static_cast<int>(HTTP::Scanner::Level()), ", head of ", Head.length(), " bytes");
+
+    Test::Log("Terminator : find ", Time(Rounds, [&] { return Text.find("\r\n\r\n"); }), " ns, scanner ", Time(Rounds, [&] { return HTTP::Scanner::Terminator(Text); }), " ns");
+
+    // Field values are scanned one line at a time
+
+    auto Values = [&](auto &&Scan)
+    {
+        size_t Sum = 0;
+
+        for (size_t Cursor = Text.find('\n') + 1; Cursor < Text.length() - 2; Cursor = Scan(Text, Cursor) + 2)
+            Sum += Cursor;
+
+        return Sum;
+    };
+
+    Test::Log("Field values : bytes ", Time(Rounds, [&] { return Values(ValueEnd); }), " ns, scanner ", Time(Rounds, [&] { return Values(HTTP::Scanner::ValueEnd); }), " ns");
+
+    Test::Log("Request target : bytes ", Time(Rounds, [&] { return TargetEnd(Text, 4); }), " ns, scanner ", Time(Rounds, [&] { return HTTP::Scanner::TargetEnd(Text, 4); }), " ns");
+
+    return 0;
+}
@@ -0,0 +1,133 @@
+#include <chrono>
+#include <string>
+#include <string_view>
+
+#include <Format/Stream.hpp>
+#include <Network/HTTP/Response.hpp>
+#include <Network/HTTP/Serializer.hpp>
+#include <Test.hpp>
+
+using namespace Core;
+using namespace Core::Network;
+
+// How Connection::AppendResponse wrote responses before the serializer, without a date header
+
+static Iterable::Queue<char> Streamed(HTTP::Response const &Response, std::string_view Extra)
+{
+    auto Buffer = Iterable::Queue<char>(256);
+    Format::Stream Ser(Buffer);
+
+    Ser << "HTTP/" << Response.Version << ' ' << std::to_string(static_cast<unsigned short>(Response.Status)) << ' ' << Response.Brief << "\r\n";
+
+    for (auto const &[k, v] : Response.Headers)
+        Ser << k << ": " << v << "\r\n";
+
+    Ser << Extra;
+
+    if (Response.Headers.find("content-length") == Response.Headers.end())
+        Ser << "content-length: " << std::to_string(Response.Content.length()) << "\r\n";
+
+    Response.SetCookies.ForEach(
+        [&](auto const &Cookie)
+        {
+            Ser << "set-cookie: " << Cookie << "\r\n";
+        });
+
+    Ser << "\r\n"
+        << Response.Content;
+
+    return Buffer;
+}
+
+static std::string Text(Iterable::Queue<char> const &Buffer)
+{
+    return {Buffer.Content(), Buffer.Length()};
+}
+
+int main(int, char const *[])
+{
+    // Sun, 06 Nov 1994 08:49:37 GMT, the example date of RFC 9110
+
+    constexpr time_t Example = 784111777;
+
+    Test::Test(
+        "Date line renders IMF-fixdate",
+        []
+        {
+            Test::Assert(HTTP::Serializer::DateLine(Example) == "date: Sun, 06 Nov 1994 08:49:37 GMT\r\n");
+            Test::Assert(HTTP::Serializer::DateLine(Example + 1) == "date: Sun, 06 Nov 1994 08:49:38 GMT\r\n", "Cached date outlived its second");
+        });
+
+    Test::Test(
+        "Standard status lines are interned",
+        []
+        {
+            auto Line = HTTP::Serializer::StatusLine("1.1", HTTP::Status::NotFound, "Not Found");
+
+            Test::Assert(Line == "HTTP/1.1 404 Not Found\r\n");
+            Test::Assert(Line.data() == HTTP::Serializer::StatusLine("1.1", HTTP::Status::NotFound, "Not Found").data());
+            Test::Assert(HTTP::Serializer::StatusLine("1.1", HTTP::Status::NotFound, "Gone Fishing").empty());
+            Test::Assert(HTTP::Serializer::StatusLine("2.0", HTTP::Status::OK, "OK").empty());
+        });
+
+    Test::Test(
+        "Serialized responses match the streamed ones plus a date",
+        []
+        {
+            auto Response = HTTP::Response::HTML("1.1", HTTP::Status::OK, "Hello, World!");
+
+            Response.SetCookies.Add("Id=1; HttpOnly");
+
+            auto Expected = Text(Streamed(Response, "connection: close\r\n"));
+            auto Result = Text(HTTP::Serializer::Serialize(Response, "connection: close\r\n", Response.Content.length(), Example));
+
+            // The date goes after content-length and before the cookies
+
+            auto Date = Expected.find("set-cookie");
+            Expected.insert(Date, "date: Sun, 06 Nov 1994 08:49:37 GMT\r\n");
+
+            Test::Assert(Result == Expected);
+        });
+
+    Test::Test(
+        "Explicit length, date and brief are kept",
+        []
+        {
+            auto Response = HTTP::Response::From("1.0", HTTP::Status::OK, {{"Content-Length", "10"}, {"Date", "Never"}}, "abc");
+
+            Response.Brief = "Fine";
+
+            auto Result = Text(HTTP::Serializer::Serialize(Response, "", 3, Example));
+
+            Test::Assert(Result.starts_with("HTTP/1.0 200 Fine\r\n"));
+            Test::Assert(Result.find("content-length") == std::string::npos && Result.find("date:") == std::string::npos);
+            Test::Assert(Result.ends_with("\r\n\r\nabc"));
+        });
+
+    // Time per response, the serializer also writes the date header
+
+    auto Response = HTTP::Response::HTML("1.1", HTTP::Status::OK, "Hello, World!");
+
+    constexpr size_t Rounds = 2000000;
+    size_t Written = 0;
+
+    auto Start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < Rounds; i++)
+        Written += Streamed(Response, "").Length();
+
+    std::chrono::duration<double, std::nano> Stream = std::chrono::steady_clock::now() - Start;
+
+    Start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < Rounds; i++)
+        Written += HTTP::Serializer::Serialize(Response, "", Response.Content.length()).Length();
+
+    std::chrono::duration<double, std::nano> Serialized = std::chrono::steady_clock::now() - Start;
+
+    Test::Assert(Written > 0);
+
+    Test::Log("Stream ", Stream.count() / Rounds, " ns/response, serializer ", Serialized.count() / Rounds, " ns/response");
+
+    return 0;
+}
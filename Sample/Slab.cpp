@@ -0,0 +1,177 @@
+#include <list>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <memory>
+
+#include <Iterable/Slab.hpp>
+#include <Test.hpp>
+
+using namespace Core;
+
+// Roughly the size of an event loop handler entry
+
+struct Payload
+{
+    uint64_t Values[12] = {};
+
+    Payload() = default;
+    Payload(uint64_t Value) { Values[0] = Value; }
+};
+
+/**
+ * @brief Keeps Live entries around and replaces a random one Rounds times,
+ * touching the replaced entry through its handle first
+ * @return Nanoseconds per replacement
+ */
+template <typename TAdd, typename TFind, typename TRemove, typename THandle>
+static double Churn(size_t Live, size_t Rounds, TAdd &&Add, TFind &&Find, TRemove &&Remove, std::vector<THandle> &Handles)
+{
+    std::mt19937 Random(7);
+    uint64_t Sum = 0;
+
+    for (size_t i = 0; i < Live; i++)
+        Handles.push_back(Add(i));
+
+    auto Start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < Rounds; i++)
+    {
+        auto &Slot = Handles[Random() % Live];
+
+        Sum += Find(Slot).Values[0];
+        Remove(Slot);
+        Slot = Add(i);
+    }
+
+    std::chrono::duration<double, std::nano> Elapsed = std::chrono::steady_clock::now() - Start;
+
+    Test::Assert(Sum != 0);
+
+    return Elapsed.count() / Rounds;
+}
+
+int main(int, char const *[])
+{
+    Test::Test(
+        "Stale handles miss recycled slots",
+        []
+        {
+            Iterable::Slab<Payload, 4> Slab;
+
+            auto First = Slab.Add(1);
+            Slab.Remove(First);
+
+            auto Second = Slab.Add(2);
+
+            Test::Assert(First.Index == Second.Index, "Freed slot was not reused");
+            Test::Assert(Slab.Find(First) == nullptr);
+            Test::Assert(Slab.Find(Second)->Values[0] == 2);
+            Test::MustThrow([&] { Slab[First]; });
+
+            // Removing through a stale handle must leave the new occupant alone
+
+            Slab.Remove(First);
+            Test::Assert(Slab.Length() == 1 && Slab.Find(Second));
+        });
+
+    Test::Test(
+        "Addresses stay stable while growing",
+        []
+        {
+            Iterable::Slab<Payload, 4> Slab;
+            std::vector<Iterable::SlabHandle> Handles;
+            std::vector<Payload *> Addresses;
+
+            for (uint64_t i = 0; i < 100; i++)
+            {
+                Handles.push_back(Slab.Add(i));
+                Addresses.push_back(Slab.Find(Handles.back()));
+            }
+
+            Test::Assert(Slab.Capacity() >= 100);
+
+            for (size_t i = 0; i < Handles.size(); i++)
+                Test::Assert(Slab.Find(Handles[i]) == Addresses[i] && Addresses[i]->Values[0] == i);
+        });
+
+    Test::Test(
+        "Free destroys every live entry",
+        []
+        {
+            auto Token = std::make_shared<int>(0);
+
+            {
+                Iterable::Slab<std::shared_ptr<int>, 8> Slab;
+                std::vector<Iterable::SlabHandle> Handles;
+
+                for (size_t i = 0; i < 20; i++)
+                    Handles.push_back(Slab.Add(Token));
+
+                for (size_t i = 0; i < 20; i += 2)
+                    Slab.Remove(Handles[i]);
+
+                Test::Assert(Token.use_count() == 11 && Slab.Length() == 10);
+            }
+
+            Test::Assert(Token.use_count() == 1);
+        });
+
+    Test::Test(
+        "Throwing constructors leave the slot free",
+        []
+        {
+            struct Throwing
+            {
+                Throwing(bool Fail)
+                {
+                    if (Fail)
+                        throw std::runtime_error("Failed");
+                }
+            };
+
+            Iterable::Slab<Throwing, 4> Slab;
+
+            Test::MustThrow([&] { Slab.Add(true); });
+            Test::Assert(Slab.IsEmpty());
+
+            auto Id = Slab.Add(false);
+
+            Test::Assert(Id.Index == 0 && Slab.Length() == 1);
+        });
+
+    // Handler churn against std::list, the container the loop used before
+
+    for (size_t Live : {1000, 10000, 100000})
+    {
+        std::list<Payload> List;
+        std::vector<std::list<Payload>::iterator> Iterators;
+
+        double ListTime = Churn(
+            Live, 1000000,
+            [&](uint64_t Value)
+            { return List.emplace(List.end(), Value + 1); },
+            [](auto Iterator) -> Payload &
+            { return *Iterator; },
+            [&](auto Iterator)
+            { List.erase(Iterator); },
+            Iterators);
+
+        Iterable::Slab<Payload> Slab;
+        std::vector<Iterable::SlabHandle> Handles;
+
+        double SlabTime = Churn(
+            Live, 1000000,
+            [&](uint64_t Value)
+            { return Slab.Add(Value + 1); },
+            [&](auto Id) -> Payload &
+            { return Slab[Id]; },
+            [&](auto Id)
+            { Slab.Remove(Id); },
+            Handles);
+
+        Test::Log(Live, " live handlers : list ", ListTime, " ns/replace, slab ", SlabTime, " ns/replace");
+    }
+
+    return 0;
+}
@@ -0,0 +1,180 @@
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <sys/socket.h>
+
+#include <Async/ThreadPool.hpp>
+#include <Async/Task.hpp>
+#include <Test.hpp>
+
+using namespace Core;
+using namespace Core::Async;
+
+static size_t Monotonic()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Runs Body on the joined loop of a pool with one more loop on its own
+ * thread, until Body sets Done or two seconds pass
+ */
+template <typename TBody>
+static void Run(TBody &&Body)
+{
+    ThreadPool Pool(Duration::FromMilliseconds(10), 1);
+    std::atomic_bool Running{true};
+    bool Done = false;
+
+    Pool.Run([&] { return Running.load(); });
+
+    Pool[1].Enqueue([&] { Body(Pool[1], Pool[0], Done); });
+
+    size_t Start = Monotonic();
+
+    Pool.GetInPool([&] { return !Done && Monotonic() - Start < 2000; });
+
+    Running = false;
+    Pool.Stop();
+
+    Test::Assert(Done, "Timed out");
+}
+
+// Tasks terminate on exceptions so they only record what the tests check
+
+static Task Sleep(EventLoop &Loop, size_t Milliseconds, size_t &Elapsed, bool &Done)
+{
+    size_t Start = Monotonic();
+
+    co_await Loop.Sleep(Duration::FromMilliseconds(Milliseconds));
+
+    Elapsed = Monotonic() - Start;
+    Done = true;
+}
+
+static Task Echo(EventLoop &Loop, Descriptor File)
+{
+    Stream Client(Loop, std::move(File));
+    char Buffer[64];
+
+    for (ssize_t Count; (Count = co_await Client.Read(Buffer, sizeof Buffer)) > 0;)
+        co_await Client.Write(Buffer, Count);
+}
+
+static Task Ping(EventLoop &Loop, Descriptor File, size_t Rounds, bool &Ordered, double &Elapsed, bool &Done)
+{
+    Stream Client(Loop, std::move(File));
+    char Message[16] = "ping";
+    char Reply[16];
+
+    auto Start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < Rounds; i++)
+    {
+        std::memcpy(Message + 4, &i, sizeof i);
+
+        co_await Client.Write(Message, sizeof Message);
+
+        ssize_t Received = 0;
+
+        while (Received < static_cast<ssize_t>(sizeof Reply))
+            Received += co_await Client.Read(Reply + Received, sizeof Reply - Received);
+
+        Ordered &= std::memcmp(Message, Reply, sizeof Reply) == 0;
+    }
+
+    Elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - Start).count() / Rounds;
+    Done = true;
+}
+
+static Task Hop(EventLoop &Loop, EventLoop &Other, bool &There, bool &Back, bool &Done)
+{
+    There = co_await Other.Call([&] { return EventLoop::Current() == &Other; });
+    Back = EventLoop::Current() == &Loop;
+
+    Done = true;
+}
+
+static Task Empty(size_t &Count)
+{
+    Count++;
+    co_return;
+}
+
+int main(int, char const *[])
+{
+    for (size_t Milliseconds : {1, 11, 35})
+    {
+        Test::Test(
+            "Sleep for " + std::to_string(Milliseconds) + " ms",
+            [Milliseconds]
+            {
+                size_t Elapsed = 0;
+
+                Run([&](EventLoop &Loop, EventLoop &, bool &Done)
+                    { Sleep(Loop, Milliseconds, Elapsed, Done); });
+
+                // Rounded up to whole 10 ms ticks, with a tick of slack for the timer
+
+                Test::Assert(Elapsed >= Milliseconds, "Woke up early");
+                Test::Assert(Elapsed <= (Milliseconds + 9) / 10 * 10 + 10, "Woke up late");
+            });
+    }
+
+    Test::Test(
+        "Call resumes on the calling loop",
+        []
+        {
+            bool There = false;
+            bool Back = false;
+
+            Run([&](EventLoop &Loop, EventLoop &Other, bool &Done)
+                { Hop(Loop, Other, There, Back, Done); });
+
+            Test::Assert(There, "Call ran on the wrong loop");
+            Test::Assert(Back, "Resumed on the wrong loop");
+        });
+
+    // Echo round trips between two coroutines on the same loop
+
+    double Elapsed = 0;
+
+    Test::Test(
+        "Streams echo in order",
+        [&Elapsed]
+        {
+            bool Ordered = true;
+            int Pair[2];
+
+            Test::Assert(socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, Pair) == 0);
+
+            Run(
+                [&](EventLoop &Loop, EventLoop &, bool &Done)
+                {
+                    Echo(Loop, Descriptor(Pair[0]));
+                    Ping(Loop, Descriptor(Pair[1]), 100000, Ordered, Elapsed, Done);
+                });
+
+            Test::Assert(Ordered, "Reply out of order");
+        });
+
+    Test::Log("Echo round trip : ", Elapsed, " ns");
+
+    // Frames come from the per-thread pool after the first one
+
+    size_t Count = 0;
+    constexpr size_t Rounds = 10000000;
+
+    auto Start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < Rounds; i++)
+        Empty(Count);
+
+    std::chrono::duration<double, std::nano> Spawn = std::chrono::steady_clock::now() - Start;
+
+    Test::Assert(Count == Rounds);
+
+    Test::Log("Task start to finish : ", Spawn.count() / Rounds, " ns");
+
+    return 0;
+}
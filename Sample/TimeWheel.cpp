@@ -0,0 +1,149 @@
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <TimeWheel.hpp>
+#include <Test.hpp>
+
+using namespace Core;
+
+using Wheel = TimeWheel<32, 5>;
+
+int main(int, char const *[])
+{
+    Test::Test(
+        "Entries fire on their deadline from any starting tick",
+        []
+        {
+            std::mt19937 Random(1);
+
+            for (size_t Round = 0; Round < 200; Round++)
+            {
+                TimeWheel<8, 4> Wheel(Duration::FromMilliseconds(1));
+
+                Wheel.Advance(Random() % 5000);
+
+                size_t Now = 0;
+                size_t Fired = 0;
+
+                for (size_t i = 0; i < 20; i++)
+                {
+                    size_t Steps = Random() % 3000 + 1;
+
+                    Wheel.Add(
+                        Steps,
+                        [&, Steps]
+                        {
+                            Test::Assert(Now == Steps, "Fired off its deadline");
+                            Fired++;
+                        });
+                }
+
+                for (Now = 1; Now <= 3000; Now++)
+                    Wheel.Tick();
+
+                Test::Assert(Fired == 20);
+            }
+        });
+
+    Test::Test(
+        "Advance skips to the next deadline",
+        []
+        {
+            Wheel Wheel(Duration::FromMilliseconds(1));
+
+            size_t Fired = 0;
+
+            Wheel.Add(5, [&]
+                      { Fired++; });
+            Wheel.Add(40000, [&]
+                      { Fired++; });
+
+            Test::Assert(Wheel.NextDeadline() == 5);
+
+            Wheel.Advance(4);
+            Test::Assert(Fired == 0 && Wheel.NextDeadline() == 1);
+
+            Wheel.Advance(1);
+            Test::Assert(Fired == 1);
+
+            Wheel.Advance(39995);
+            Test::Assert(Fired == 2 && Wheel.NextDeadline() == 0);
+        });
+
+    Test::Test(
+        "Callbacks remove themselves and their siblings",
+        []
+        {
+            Wheel Wheel(Duration::FromMilliseconds(1));
+            std::vector<Wheel::Bucket::Iterator> Entries(100);
+            size_t Fired = 0;
+
+            for (size_t i = 0; i < Entries.size(); i++)
+            {
+                Entries[i] = Wheel.Add(
+                    5,
+                    [&, i]
+                    {
+                        Fired++;
+                        Wheel.Remove(Entries[i]);
+
+                        if (i % 2 == 0 && i + 1 < Entries.size())
+                            Wheel.Remove(Entries[i + 1]);
+                    });
+            }
+
+            Wheel.Advance(10);
+
+            Test::Assert(Fired == 50);
+        });
+
+    // Schedule and cancel churn the way connection idle timeouts use the wheel
+
+    for (size_t Live : {10000, 100000, 1000000})
+    {
+        Wheel Wheel(Duration::FromMilliseconds(1));
+        std::vector<Wheel::Bucket::Iterator> Entries;
+        std::mt19937 Random(3);
+
+        for (size_t i = 0; i < Live; i++)
+            Entries.push_back(Wheel.Add(Random() % 60000 + 1, [] {}));
+
+        constexpr size_t Rounds = 1000000;
+
+        auto Start = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i < Rounds; i++)
+        {
+            auto &Entry = Entries[Random() % Live];
+
+            Wheel.Remove(Entry);
+            Entry = Wheel.Add(Random() % 60000 + 1, [] {});
+        }
+
+        std::chrono::duration<double, std::nano> Churn = std::chrono::steady_clock::now() - Start;
+
+        // Every entry cascades down and fires
+
+        size_t Fired = 0;
+
+        for (auto &Entry : Entries)
+        {
+            Wheel.Remove(Entry);
+            Entry = Wheel.Add(Random() % 60000 + 1, [&Fired]
+                              { Fired++; });
+        }
+
+        Start = std::chrono::steady_clock::now();
+
+        Wheel.Advance(60001);
+
+        std::chrono::duration<double, std::nano> Expire = std::chrono::steady_clock::now() - Start;
+
+        Test::Assert(Fired == Live);
+
+        Test::Log(Live, " live timers : ", Churn.count() / Rounds, " ns/reschedule, ", Expire.count() / Live, " ns/expiry");
+    }
+
+    return 0;
+}
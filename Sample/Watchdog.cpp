@@ -0,0 +1,118 @@
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <typeinfo>
+
+#include <Event.hpp>
+#include <Async/ThreadPool.hpp>
+#include <Test.hpp>
+
+using namespace Core;
+using namespace Core::Async;
+
+// Callback with a type of its own so reports can be matched against it
+
+struct Sleeper
+{
+    size_t *Calls;
+
+    void operator()(EventLoop::Context &, ePoll::Entry &) const
+    {
+        if ((*Calls)++ == 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    }
+};
+
+int main(int, char const *[])
+{
+    Test::Test(
+        "A stalled callback is reported while it runs and once it returned",
+        []
+        {
+            ThreadPool Pool(Duration::FromMilliseconds(10), 0);
+            auto &Loop = Pool[0];
+
+            std::mutex Lock;
+            std::vector<Watchdog::Stall> Reports;
+            EventLoop::Handle Id;
+            size_t Calls = 0;
+
+            Pool.Watch(
+                Duration::FromMilliseconds(40),
+                [&](Watchdog::Stall const &Report)
+                {
+                    std::lock_guard Guard(Lock);
+                    Reports.push_back(Report);
+                });
+
+            Loop.Enqueue([&] { Id = Loop.Attach(Event(1, 0), Sleeper{&Calls}); });
+
+            auto Start = std::chrono::steady_clock::now();
+
+            // Runs until the report made after the stall, which takes a scan past its end
+
+            Pool.Run([] { return true; });
+            Pool.GetInPool(
+                [&]
+                {
+                    std::lock_guard Guard(Lock);
+                    return Reports.size() < 2 && std::chrono::steady_clock::now() - Start < std::chrono::seconds(2);
+                });
+            Pool.Stop();
+
+            Test::Assert(Reports.size() == 2, "Expected one report while stalled and one after");
+            Test::Assert(Reports[0].Ongoing && !Reports[1].Ongoing);
+            Test::Assert(Reports[0].Entry.Pack() == Id.Pack() && Reports[0].Type == typeid(Sleeper).name(), "Report names the wrong callback");
+            Test::Assert(Reports[1].Elapsed.AsMilliseconds() >= 150, "Final report is short of the stall");
+        });
+
+    Test::Test(
+        "Short callbacks are never a stall",
+        []
+        {
+            ThreadPool Pool(Duration::FromMilliseconds(10), 0);
+            auto &Loop = Pool[0];
+
+            size_t Reports = 0;
+            auto Start = std::chrono::steady_clock::now();
+
+            Pool.Watch(Duration::FromMilliseconds(20), [&](Watchdog::Stall const &) { Reports++; });
+
+            Loop.Enqueue([&] { Loop.Attach(Event(1, 0), [](EventLoop::Context &, ePoll::Entry &) {}); });
+
+            Pool.Run([] { return true; });
+            Pool.GetInPool([&] { return std::chrono::steady_clock::now() - Start < std::chrono::milliseconds(300); });
+            Pool.Stop();
+
+            Test::Assert(Reports == 0);
+        });
+
+    // Cost per dispatched event with the heartbeat published, build with
+    // COREKIT_NO_HEARTBEAT to compare
+
+    {
+        ThreadPool Pool(Duration::FromMilliseconds(10), 0);
+        auto &Loop = Pool[0];
+
+        size_t Dispatched = 0;
+
+        Loop.Enqueue(
+            [&]
+            {
+                for (size_t i = 0; i < 1000; i++)
+                    Loop.Attach(Event(1, 0), [&](EventLoop::Context &, ePoll::Entry &) { Dispatched++; });
+            });
+
+        auto Start = std::chrono::steady_clock::now();
+
+        Pool.Run([] { return true; });
+        Pool.GetInPool([&] { return Dispatched < 2000000; });
+
+        std::chrono::duration<double, std::nano> Elapsed = std::chrono::steady_clock::now() - Start;
+
+        Test::Log("Dispatch : ", Elapsed.count() / Dispatched, " ns/event");
+    }
+
+    return 0;
+}